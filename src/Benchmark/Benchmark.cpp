@@ -0,0 +1,365 @@
+//
+//  Benchmark.cpp
+//  wolverine_engine
+//
+//  wolverine-bench: builds a synthetic scene in memory, runs the engine headless for a fixed number of frames,
+//  and reports frame times, allocations, and the size of the Lua heap as JSON.
+//
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Engine.h"
+#include "InputManager.h"
+#include "ImageDB.h"
+#include "ComponentDB.h"
+#include "SceneManager.h"
+#include "EngineUtils.h"
+#include "LuaAllocator.h"
+#include "LuaGC.h"
+
+//-------------------------------------------------------
+// Allocation tracking
+// Every operator new in the program goes through here so the allocations made each frame can be counted
+
+static std::atomic<unsigned long long> allocation_count{0}; // The number of allocations made since the program started
+static std::atomic<unsigned long long> allocation_bytes{0}; // The number of bytes allocated since the program started
+
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) { throw std::bad_alloc(); }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+//-------------------------------------------------------
+// Settings
+
+struct BenchSettings
+{
+    int lua_actors = 1000; // Actors with a Lua component that has OnUpdate
+    int rigidbodies = 100; // Actors with a dynamic Rigidbody
+    int particle_systems = 10; // Actors with a looping ParticleSystem
+    int sprites = 1000; // Actors with a SpriteRenderer
+    int warmup_frames = 60; // Frames that are run before anything is measured
+    int frames = 600; // Frames that are measured
+    std::string output_path = ""; // Where the JSON report is written, stdout if empty
+};
+
+// The Lua component that every lua actor gets, does a small amount of work each frame like a typical gameplay script
+static const char* bench_component_source = R"(
+BenchMover = {
+    speed = 1.0,
+    x = 0.0,
+    y = 0.0,
+
+    OnUpdate = function(self)
+        self.x = self.x + self.speed * Time.DeltaTime()
+        if self.x > 100.0 then
+            self.x = 0.0
+            self.y = self.y + 1.0
+        end
+    end
+}
+)";
+
+/**
+ * Prints how to use wolverine-bench
+ */
+static void PrintUsage()
+{
+    std::cout << "usage: wolverine-bench [--lua N] [--bodies M] [--particles K] [--sprites S] [--frames F] [--warmup W] [--output path]" << std::endl;
+}
+
+/**
+ * Reads the command line arguments into the settings
+ *
+ * @param    argc        the number of arguments
+ * @param    argv        the arguments given to main
+ * @param    settings    the settings to fill in
+ * @returns              false if the arguments couldn't be read
+ */
+static bool ParseArguments(int argc, char* argv[], BenchSettings& settings)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+
+        if (i + 1 >= argc) { return false; }
+        std::string value = argv[++i];
+
+        if (arg == "--lua") { settings.lua_actors = std::max(std::atoi(value.c_str()), 0); }
+        else if (arg == "--bodies") { settings.rigidbodies = std::max(std::atoi(value.c_str()), 0); }
+        else if (arg == "--particles") { settings.particle_systems = std::max(std::atoi(value.c_str()), 0); }
+        else if (arg == "--sprites") { settings.sprites = std::max(std::atoi(value.c_str()), 0); }
+        else if (arg == "--frames") { settings.frames = std::max(std::atoi(value.c_str()), 1); }
+        else if (arg == "--warmup") { settings.warmup_frames = std::max(std::atoi(value.c_str()), 0); }
+        else if (arg == "--output") { settings.output_path = value; }
+        else { return false; }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------
+// Scene generation
+
+/**
+ * Adds an actor with a single component to a scene document
+ *
+ * @param    scene        the scene document to add the actor to
+ * @param    name         the name of the new actor
+ * @param    component    the only component of the new actor, must be allocated with the scene's allocator
+ */
+static void AddActor(rapidjson::Document& scene, const char* name, rapidjson::Value& component)
+{
+    rapidjson::Document::AllocatorType& allocator = scene.GetAllocator();
+
+    rapidjson::Value components(rapidjson::kObjectType);
+    components.AddMember("1", component, allocator);
+
+    rapidjson::Value actor(rapidjson::kObjectType);
+    actor.AddMember("name", rapidjson::StringRef(name), allocator);
+    actor.AddMember("components", components, allocator);
+
+    scene["actors"].PushBack(actor, allocator);
+}
+
+/**
+ * Builds a scene document with the number of each kind of actor asked for
+ * Bodies and emitters are spread out on a grid so they don't all start on top of each other
+ *
+ * @param    settings    how many of each actor to create
+ * @param    scene       the document to build the scene in
+ */
+static void BuildScene(const BenchSettings& settings, rapidjson::Document& scene)
+{
+    scene.SetObject();
+    rapidjson::Document::AllocatorType& allocator = scene.GetAllocator();
+    scene.AddMember("actors", rapidjson::Value(rapidjson::kArrayType), allocator);
+
+    const int grid_width = 100;
+
+    for (int i = 0; i < settings.lua_actors; i++)
+    {
+        rapidjson::Value component(rapidjson::kObjectType);
+        component.AddMember("type", "BenchMover", allocator);
+        component.AddMember("speed", 1.0f + (i % 10), allocator);
+        AddActor(scene, "BenchLua", component);
+    }
+
+    for (int i = 0; i < settings.rigidbodies; i++)
+    {
+        rapidjson::Value component(rapidjson::kObjectType);
+        component.AddMember("type", "Rigidbody", allocator);
+        component.AddMember("x", static_cast<float>(i % grid_width) * 1.5f, allocator);
+        component.AddMember("y", static_cast<float>(i / grid_width) * -1.5f, allocator);
+        component.AddMember("has_collider", true, allocator);
+        AddActor(scene, "BenchBody", component);
+    }
+
+    for (int i = 0; i < settings.particle_systems; i++)
+    {
+        rapidjson::Value component(rapidjson::kObjectType);
+        component.AddMember("type", "ParticleSystem", allocator);
+        component.AddMember("image", "bench_sprite", allocator);
+        component.AddMember("loop", true, allocator);
+        component.AddMember("emission_rate", 20, allocator);
+        component.AddMember("particle_lifetime", 2.0f, allocator);
+        component.AddMember("emitter_pos_x", static_cast<float>(i % grid_width) * 10.0f, allocator);
+        component.AddMember("emitter_pos_y", static_cast<float>(i / grid_width) * 10.0f, allocator);
+        AddActor(scene, "BenchParticles", component);
+    }
+
+    for (int i = 0; i < settings.sprites; i++)
+    {
+        rapidjson::Value component(rapidjson::kObjectType);
+        component.AddMember("type", "SpriteRenderer", allocator);
+        component.AddMember("sprite", "bench_sprite", allocator);
+        component.AddMember("x", static_cast<float>(i % grid_width), allocator);
+        component.AddMember("y", static_cast<float>(i / grid_width), allocator);
+        AddActor(scene, "BenchSprite", component);
+    }
+}
+
+//-------------------------------------------------------
+// Reporting
+
+/**
+ * Gets a percentile out of a sorted list of samples
+ *
+ * @param    sorted_samples    the samples, sorted from smallest to largest
+ * @param    percentile        [0, 1] the percentile to get
+ * @returns                    the sample at that percentile
+ */
+static double Percentile(const std::vector<double>& sorted_samples, const double percentile)
+{
+    size_t index = std::min(sorted_samples.size() - 1, static_cast<size_t>(sorted_samples.size() * percentile));
+    return sorted_samples[index];
+}
+
+/**
+ * @returns    the number of bytes the Lua state is currently using
+ */
+static long long GetLuaHeapBytes()
+{
+    return static_cast<long long>(LuaAllocator::GetLiveBytes());
+}
+
+//-------------------------------------------------------
+
+/**
+ * Builds the synthetic scene, runs the engine headless, and writes the report
+ */
+int main(int argc, char* argv[])
+{
+    BenchSettings settings;
+    if (!ParseArguments(argc, argv, settings))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // Only the parts of Initialize that don't read from resources/, everything else is created in memory
+    EngineData::headless = true;
+    RendererData::SetHeadless(true);
+
+    LuaAPI::InitLuaState();
+    LuaAPI::ExposeLuaAPI();
+    Input::Init();
+
+    LuaGC::Init(LUA_GC_MODE_INCREMENTAL, 1.0, 16);
+
+    AddComponentType("BenchMover", bench_component_source);
+    AddImage("bench_sprite", nullptr);
+
+    Uint64 load_start = SDL_GetPerformanceCounter();
+    {
+        rapidjson::Document scene;
+        BuildScene(settings, scene);
+        Scene::LoadSceneWithJSON("bench", scene);
+    }
+    double load_ms = static_cast<double>(SDL_GetPerformanceCounter() - load_start) * 1000.0 / SDL_GetPerformanceFrequency();
+
+    Time::SetFrameDeltaOverride(Time::GetFixedDeltaTime());
+    Time::Init();
+
+    for (int i = 0; i < settings.warmup_frames; i++) { GameLoop(); }
+
+    long long lua_heap_start = GetLuaHeapBytes();
+    unsigned long long allocations_start = allocation_count.load();
+    unsigned long long allocated_bytes_start = allocation_bytes.load();
+    unsigned long long lua_allocations_start = LuaAllocator::GetTotalAllocations();
+
+    std::vector<double> frame_ms;
+    frame_ms.reserve(settings.frames);
+
+    Uint64 run_start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < settings.frames; i++)
+    {
+        Uint64 frame_start = SDL_GetPerformanceCounter();
+        if (GameLoop() == 1) { break; }
+        frame_ms.push_back(static_cast<double>(SDL_GetPerformanceCounter() - frame_start) * 1000.0 / SDL_GetPerformanceFrequency());
+    }
+    double run_seconds = static_cast<double>(SDL_GetPerformanceCounter() - run_start) / SDL_GetPerformanceFrequency();
+
+    unsigned long long allocations = allocation_count.load() - allocations_start;
+    unsigned long long allocated_bytes = allocation_bytes.load() - allocated_bytes_start;
+    long long lua_heap_end = GetLuaHeapBytes();
+    unsigned long long lua_allocations = LuaAllocator::GetTotalAllocations() - lua_allocations_start;
+
+    if (frame_ms.empty())
+    {
+        std::cout << "error: no frames were run" << std::endl;
+        return 1;
+    }
+
+    double total_ms = 0.0;
+    for (double sample : frame_ms) { total_ms += sample; }
+    std::sort(frame_ms.begin(), frame_ms.end());
+
+    const size_t measured_frames = frame_ms.size();
+
+    rapidjson::Document report;
+    report.SetObject();
+    rapidjson::Document::AllocatorType& allocator = report.GetAllocator();
+
+    rapidjson::Value scene_info(rapidjson::kObjectType);
+    scene_info.AddMember("lua_actors", settings.lua_actors, allocator);
+    scene_info.AddMember("rigidbodies", settings.rigidbodies, allocator);
+    scene_info.AddMember("particle_systems", settings.particle_systems, allocator);
+    scene_info.AddMember("sprites", settings.sprites, allocator);
+    scene_info.AddMember("load_ms", load_ms, allocator);
+    report.AddMember("scene", scene_info, allocator);
+
+    rapidjson::Value frame_info(rapidjson::kObjectType);
+    frame_info.AddMember("warmup", settings.warmup_frames, allocator);
+    frame_info.AddMember("measured", static_cast<uint64_t>(measured_frames), allocator);
+    frame_info.AddMember("min_ms", frame_ms.front(), allocator);
+    frame_info.AddMember("avg_ms", total_ms / measured_frames, allocator);
+    frame_info.AddMember("p50_ms", Percentile(frame_ms, 0.50), allocator);
+    frame_info.AddMember("p90_ms", Percentile(frame_ms, 0.90), allocator);
+    frame_info.AddMember("p99_ms", Percentile(frame_ms, 0.99), allocator);
+    frame_info.AddMember("max_ms", frame_ms.back(), allocator);
+    frame_info.AddMember("frames_per_second", measured_frames / std::max(run_seconds, 0.000001), allocator);
+    report.AddMember("frames", frame_info, allocator);
+
+    rapidjson::Value allocation_info(rapidjson::kObjectType);
+    allocation_info.AddMember("count", static_cast<uint64_t>(allocations), allocator);
+    allocation_info.AddMember("bytes", static_cast<uint64_t>(allocated_bytes), allocator);
+    allocation_info.AddMember("count_per_frame", static_cast<double>(allocations) / measured_frames, allocator);
+    allocation_info.AddMember("bytes_per_frame", static_cast<double>(allocated_bytes) / measured_frames, allocator);
+    report.AddMember("allocations", allocation_info, allocator);
+
+    rapidjson::Value lua_info(rapidjson::kObjectType);
+    lua_info.AddMember("heap_bytes_start", static_cast<int64_t>(lua_heap_start), allocator);
+    lua_info.AddMember("heap_bytes_end", static_cast<int64_t>(lua_heap_end), allocator);
+    lua_info.AddMember("heap_bytes_peak", static_cast<uint64_t>(LuaAllocator::GetPeakBytes()), allocator);
+    lua_info.AddMember("allocations", static_cast<uint64_t>(lua_allocations), allocator);
+    lua_info.AddMember("allocations_per_frame", static_cast<double>(lua_allocations) / measured_frames, allocator);
+    report.AddMember("lua", lua_info, allocator);
+
+    report.AddMember("draw_requests", static_cast<int64_t>(RendererData::GetHeadlessDrawCount()), allocator);
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    report.Accept(writer);
+
+    if (settings.output_path == "")
+    {
+        std::cout << buffer.GetString() << std::endl;
+    }
+    else
+    {
+        std::ofstream output(settings.output_path);
+        if (!output.is_open())
+        {
+            std::cout << "error: could not write benchmark report to " << settings.output_path << std::endl;
+            return 1;
+        }
+        output << buffer.GetString() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+//
+//  ActorBlueprint.h
+//  wolverine_engine
+//
+//  Actor JSON compiled once into ready-made Lua values, so creating an actor doesn't have to walk or convert any JSON
+//
+
+#ifndef ActorBlueprint_h
+#define ActorBlueprint_h
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sol/sol.hpp"
+
+#include "EngineUtils.h"
+
+/**
+ * A component of an actor blueprint
+ */
+struct ComponentBlueprint
+{
+    sol::object type; // The name of the component type as a Lua string
+    sol::object key; // The key of the component as a Lua string
+    int type_id = -1; // See StringTable
+    int key_id = -1; // See StringTable
+    int native_type = -1; // The native type ID of C++ components, which are made by the ComponentManager instead of from a table, -1 for Lua components
+    std::string type_name;
+
+    sol::table metatable; // Shared by every instance of a Lua component, inherits from the component type
+
+    // The properties the JSON sets, already converted to the Lua type the component expects
+    // Table values are copied for each instance, every other value is shared
+    std::vector<std::pair<sol::object, sol::object>> properties;
+};
+
+/**
+ * An actor compiled from JSON (a template, or an actor in a scene combined with its template)
+ */
+struct ActorBlueprint
+{
+    int name_id = -1; // See StringTable
+    bool enabled = true;
+    std::vector<ComponentBlueprint> components;
+
+    // Pooling, set by templates (see Actors::LoadActorFromTemplate)
+    bool pooled = false;
+    int prewarm = 0;
+    int pool_id = -1; // The pool of this blueprint once one has been made
+};
+
+class Blueprints
+{
+private:
+    inline static std::unordered_map<std::string, std::unique_ptr<ActorBlueprint>> template_blueprints; // Template name -> blueprint
+    inline static std::unordered_map<std::string, std::vector<std::unique_ptr<ActorBlueprint>>> scene_blueprints; // Scene name -> the blueprint of every actor in the scene
+    inline static std::unordered_map<std::string, sol::table> type_metatables; // Component type name -> the metatable its components share
+
+    /**
+     * Gets the metatable shared by every component of a Lua component type
+     *
+     * @param   type_name    the name of the component type
+     * @returns              the metatable, its __index is the component type
+    */
+    static sol::table GetTypeMetatable(const std::string& type_name);
+
+    /**
+     * Compiles a component from its JSON
+     *
+     * @param   key               the key of the component
+     * @param   component_data    the JSON of the component
+     * @param   actor_name        the name of the actor, for errors
+     * @returns                   the compiled component
+    */
+    static ComponentBlueprint CompileComponent(const std::string& key, const rapidjson::Value& component_data, const std::string& actor_name);
+
+public:
+    /**
+     * Compiles the JSON of an actor into a blueprint
+     *
+     * @param   actor_data    the JSON of the actor, structured the same as a template
+     * @returns               the compiled blueprint
+    */
+    static std::unique_ptr<ActorBlueprint> Compile(const rapidjson::Value& actor_data);
+
+    /**
+     * Compiles every actor in a scene document, combining actors with their templates first
+     *
+     * @param   scene_data    the scene document, structured the same as a .scene file
+     * @returns               the blueprint of every actor in the scene, in order
+    */
+    static std::vector<std::unique_ptr<ActorBlueprint>> CompileScene(const rapidjson::Value& scene_data);
+
+    /**
+     * Compiles every loaded template, called once at startup after the component types and templates are loaded
+    */
+    static void CompileTemplates();
+
+    /**
+     * Gets the blueprint of a template, compiling it if it hasn't been yet
+     *
+     * @param   template_name    the name of the template
+     * @returns                  the blueprint of the template
+    */
+    static ActorBlueprint& GetTemplateBlueprint(const std::string& template_name);
+
+    /**
+     * Gets the blueprints of every actor in a scene in resources/scenes, the scene file is only read and compiled the first time
+     *
+     * @param   scene_name    the name of the scene
+     * @returns               the blueprint of every actor in the scene, in order
+    */
+    static const std::vector<std::unique_ptr<ActorBlueprint>>& GetSceneBlueprints(const std::string& scene_name);
+
+    /**
+     * Gets a property value for a new component
+     * Tables are copied so components never share one, every other value is returned as is
+     *
+     * @param   value    a property value from a blueprint
+     * @returns          the value to give the component
+    */
+    static sol::object CopyValue(const sol::object& value);
+};
+
+#endif /* ActorBlueprint_h */
@@ -16,6 +16,9 @@
 
 #include "TemplateDB.h"
 #include "ComponentManager.h"
+#include "StringTable.h"
+#include "ActorBlueprint.h"
+#include "ScriptProfiler.h"
 
 using namespace std;
 
@@ -28,6 +31,118 @@ public:
     int ID = -1;
 };
 
+/**
+ * Where an actor ID points to in the actor vectors
+ * An actor ID is a slot index in the low ACTOR_SLOT_BITS bits and the slot's generation in the bits above it.
+ * The generation goes up every time the slot is freed, so IDs of destroyed actors stop resolving even after the slot is reused.
+ */
+struct ActorSlot
+{
+    int index = -1; // The index of the actor in the vectors, -1 while the slot is free
+    int generation = 0; // Must match the generation in an ID for the ID to be valid
+};
+
+/**
+ * The type and key of a component as StringTable IDs, so components can be searched for without reading their Lua tables
+ */
+struct ComponentIndexEntry
+{
+    int type_id = -1;
+    int key_id = -1;
+};
+
+/**
+ * The engine's record of a component on an actor, shared by every lifecycle list the component is in
+ * A pooled component gets a new record each time it is reused, so records of earlier uses can't come back to life
+ */
+struct ComponentState : std::enable_shared_from_this<ComponentState>
+{
+    std::shared_ptr<sol::table> component;
+    int actor_id = -1;
+    int type_id = -1; // See StringTable
+    int key_id = -1; // See StringTable
+    int batch = -1; // The index of the component's type in Actors::type_batches, -1 if its type has no batched functions
+    int update_bucket = -1; // The index in Actors::update_buckets that "OnUpdate" is scheduled in
+    
+    // Native components are started, updated, and destroyed directly instead of through Lua
+    int native_type = -1; // See ComponentManager::GetNativeComponentType
+    void* native = nullptr; // The component's C++ object, kept alive by "component"
+    
+    bool enabled = true; // Changed through Actors::SetComponentEnabled
+    bool removed = false; // Set once the component is removed from its actor or its actor is destroyed
+    bool started = false; // Set once "OnStart" has been called
+    bool waiting_to_start = false; // True while the component is in "components_to_init"
+    
+    std::vector<int> coroutines; // The handles of the coroutines the component started that haven't finished, see Coroutines
+    
+    // Goes up every time the component is added to or taken out of the update lists
+    // Entries in the update lists made before the last change no longer match, so they are dropped instead of being run
+    int activation = 0;
+    bool active = false; // True while the component is in the update lists
+    
+    // The per-frame lifecycle functions, looked up once when the component starts so the update loops only have to call them
+    // Not valid if the component doesn't have the function, which also keeps it out of that update list
+    sol::protected_function on_update;
+    sol::protected_function on_late_update;
+    sol::protected_function on_fixed_update;
+};
+
+/**
+ * An entry in one of the update lists
+ */
+struct ComponentRef
+{
+    std::shared_ptr<ComponentState> state;
+    int activation = 0; // Only live while this matches the activation of the state
+    int phase = 0; // Which frame of its bucket's interval a time sliced entry runs on
+};
+
+/**
+ * The components whose "OnUpdate" runs on the same schedule, set by "update_group", "update_priority", "update_interval", and "update_sliced"
+ */
+struct UpdateBucket
+{
+    int group_id = -1; // The name of the execution group (see StringTable)
+    int priority = 0; // Buckets with a lower priority run first
+    int interval = 1; // The components run once every "interval" frames
+    bool sliced = false; // If true the components are spread across the interval, so a different part of them runs each frame
+    
+    std::vector<ComponentRef> components;
+    int next_phase = 0; // The phase the next component added to a sliced bucket gets
+};
+
+/**
+ * The batched lifecycle functions of a component type ("OnUpdateAll", "OnLateUpdateAll", and "OnFixedUpdateAll")
+ * A batched function is called once per frame with every active component of the type, instead of calling the per-component function on each one
+ */
+struct ComponentTypeBatch
+{
+    sol::protected_function on_update_all;
+    sol::protected_function on_late_update_all;
+    sol::protected_function on_fixed_update_all;
+    
+    // The active components of the type, one list for each batched function the type has
+    std::vector<ComponentRef> to_update;
+    std::vector<ComponentRef> to_update_late;
+    std::vector<ComponentRef> to_update_fixed;
+    
+    sol::table instances; // The array passed to the batched functions, refilled before every call
+    int num_instances = 0; // How much of "instances" was filled last time
+    
+    int type_id = -1; // See StringTable, the batched functions show up in the script profiler under the type with "*" as the key
+};
+
+/**
+ * The destroyed actors of a pooled template, waiting to be reused by Instantiate
+ * An instance is the component list of one actor, in the same order as the components in the template
+ */
+struct ActorPool
+{
+    const ActorBlueprint* blueprint = nullptr;
+    std::vector<ComponentIndexEntry> component_lookup; // The same for every instance
+    std::vector< std::vector< std::shared_ptr<sol::table>>> free_instances;
+};
+
 /**
  * The real Actor class storing all of the Actor information
  */
@@ -37,44 +152,241 @@ private:
     static int num_total_actors; // The total number of actors created during runtime
     static int num_loaded_actors; // The number of actors currently loaded in the game
     
-    static std::unordered_map<int, int> id_to_index; // map of an actors id to its current index in the vectors
+    // Actor IDs are never negative, so a slot index gets 20 bits (about a million live actors) and the generation gets the other 11
+    inline static const int ACTOR_SLOT_BITS = 20;
+    inline static const int ACTOR_SLOT_MASK = (1 << ACTOR_SLOT_BITS) - 1;
+    inline static const int ACTOR_GENERATION_MASK = (1 << 11) - 1;
+    
+    inline static std::vector<ActorSlot> slots; // Indexed by the slot part of an actor ID
+    inline static std::queue<int> free_slots; // Slots are reused oldest first so a generation takes as long as possible to come back around
     
     /**
      * Gets the vector index of the actor with the given ID
      *
      * @param   actor_id the id of the actor that this function is acting on
+     * @returns          the index of the actor in the vectors, -1 if the actor doesn't exist or has been destroyed
     */
-    static int GetIndex(int actor_id);
+    static inline int GetIndex(int actor_id)
+    {
+        int slot = actor_id & ACTOR_SLOT_MASK;
+        if (actor_id < 0 || slot >= static_cast<int>(slots.size())) { return -1; }
+        
+        const ActorSlot& actor_slot = slots[slot];
+        if (actor_slot.generation != (actor_id >> ACTOR_SLOT_BITS)) { return -1; }
+        
+        return actor_slot.index;
+    }
     
     // The attributes of all the loaded actors
-    static std::vector<std::string> names;
+    // These are kept packed, destroying an actor moves the last actor into its place
+    static std::vector<int> name_ids; // Interned in the StringTable
     static std::vector<int> IDs;
     static std::vector<bool> actor_enabled;
+    inline static std::vector<int> actor_pools; // The pool the actor goes back to when it is destroyed, -1 if it isn't pooled
     
     // The components of all the loaded actors
     // Layer 1: the index of the actor
     // Layer 2: the index of the component on the actor
     inline static std::vector< std::vector< std::shared_ptr<sol::table>>> components;
     
+    // The type and key of every component, laid out the same as "components"
+    inline static std::vector< std::vector<ComponentIndexEntry>> component_lookup;
+    
+    // The record of every component, laid out the same as "components"
+    inline static std::vector< std::vector< std::shared_ptr<ComponentState>>> component_states;
+    
+    /**
+     * Finds the first component on an actor with the given type and/or key
+     *
+     * @param   actor_index    the index of the actor in the vectors
+     * @param   type_id        the type ID to match, -1 matches any type
+     * @param   key_id         the key ID to match, -1 matches any key
+     * @returns                the index of the component on the actor, -1 if none match
+    */
+    static inline int FindComponent(int actor_index, int type_id, int key_id)
+    {
+        const std::vector<ComponentIndexEntry>& entries = component_lookup[actor_index];
+        for (int i = 0; i < static_cast<int>(entries.size()); i++)
+        {
+            if ((type_id == -1 || entries[i].type_id == type_id) && (key_id == -1 || entries[i].key_id == key_id)) { return i; }
+        }
+        return -1;
+    }
+    
     // All components that need to be initialized this frame
-    inline static std::vector<std::shared_ptr<sol::table>> components_to_init;
+    // Components that are disabled, or on a disabled actor, wait outside of every list until they are enabled
+    inline static std::vector<std::shared_ptr<ComponentState>> components_to_init;
     
-    // All components that need to be deleted this frame
-    inline static std::queue<std::shared_ptr<sol::table>> components_to_delete;
+    // The components being started this frame, kept between frames so its storage is reused
+    inline static std::vector<std::shared_ptr<ComponentState>> components_starting;
     
-    // The components across all actors with lifecycle functions
-    inline static std::vector<std::shared_ptr<sol::table>> components_to_update;
-    inline static std::vector<std::shared_ptr<sol::table>> components_to_update_late;
+    // All components that need to be deleted this frame, and whether they go back to a pool instead of being deleted
+    // Cleared instead of popped so its storage is reused
+    inline static std::vector<std::pair<std::shared_ptr<ComponentState>, bool>> components_to_delete;
+    
+    // The started components across all enabled actors with lifecycle functions
+    // Disabled components are taken out, so these only hold work that will run
+    // Dead entries are compacted out in place while the list runs, so a frame with nothing added doesn't allocate
+    inline static std::vector<ComponentRef> components_to_update_late;
+    inline static std::vector<ComponentRef> components_to_update_fixed;
+    
+    // The started native components with an "OnUpdate", one list for each native component type
+    // Each type is run by its own loop that calls the C++ function directly
+    inline static std::vector<std::vector<ComponentRef>> native_components_to_update; // Indexed by native type ID
+    
+    // The scheduler for "OnUpdate", every combination of group, priority, and interval in use has its own bucket
+    // Buckets are never removed or moved, so components can keep the index of their bucket
+    inline static std::vector<UpdateBucket> update_buckets;
+    inline static std::vector<int> update_order; // Indexes into "update_buckets", sorted by priority and then by when the bucket was made
+    inline static std::vector<int> disabled_update_groups; // The group IDs of every execution group that has been paused
+    inline static int update_frame = 0; // The number of times Update has run, for the intervals
+    
+    inline static ComponentState* running_component = nullptr; // The component whose lifecycle function is running, nullptr outside of one
+    
+    // Every component type with batched functions, the components of these types are kept in the type's lists instead of the ones above
+    inline static std::vector<ComponentTypeBatch> type_batches;
+    inline static std::vector<int> type_batch_ids; // Indexed by type ID, the index in "type_batches", -1 if the type has none, -2 if it hasn't been checked yet
+    
+    /**
+     * Makes the record of a new component and queues it to start if it and its actor are enabled
+     *
+     * @param   component    the component
+     * @param   actor_id     the id of the actor the component is on, it must be the last actor in the vectors
+     * @param   type_id      the ID of the component's type
+     * @param   key_id       the ID of the component's key
+    */
+    static void AddComponentState(const std::shared_ptr<sol::table>& component, int actor_id, int type_id, int key_id);
+    
+    /**
+     * Moves a component in or out of the lifecycle lists to match whether it and its actor are enabled
+     *
+     * @param   state    the record of the component
+    */
+    static void UpdateActivation(const std::shared_ptr<ComponentState>& state);
+    
+    /**
+     * Calls one lifecycle function on every live component in an update list, dropping entries that are no longer live
+     *
+     * @param   list        the update list
+     * @param   function    the lifecycle function of each component to call
+     * @param   callback    the callback to report to the script profiler
+     * @param   phase       if not -1, only entries with this phase are called, the rest are only kept
+    */
+    static void RunUpdateList(std::vector<ComponentRef>& list, sol::protected_function ComponentState::* function, SCRIPT_CALLBACK callback, int phase = -1);
+    
+    /**
+     * Gets the bucket a component's "OnUpdate" is scheduled in, making it if no other component has used the same schedule yet
+     * The schedule is read from the component, so it can be set on the component type or on each component in a template or scene
+     *
+     * @param   component    the component
+     * @returns              the index of the bucket in "update_buckets"
+    */
+    static int GetUpdateBucket(const sol::table& component);
+    
+    /**
+     * Calls "OnUpdate" on every live native component of one type, dropping entries that are no longer live
+     * Works the same as RunUpdateList, without going through Lua
+     *
+     * @param   list         the update list of the native component type
+     * @param   on_update    the "OnUpdate" of the native component type
+    */
+    static inline void RunNativeUpdateList(std::vector<ComponentRef>& list, void (*on_update)(void* native))
+    {
+        // Native "OnUpdate" can't add to the list, so it is compacted as it runs
+        size_t num_living = 0;
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            ComponentState* state = list[i].state.get();
+            if (list[i].activation != state->activation) { continue; }
+            
+            if (num_living != i) { list[num_living] = std::move(list[i]); }
+            num_living++;
+            
+            on_update(state->native);
+        }
+        list.resize(num_living);
+    }
+    
+    /**
+     * Gets the batched functions of a component's type, looking them up the first time a component of the type starts
+     *
+     * @param   component    a component of the type
+     * @param   type_id      the ID of the type
+     * @returns              the index of the type in "type_batches", -1 if the type has no batched functions
+    */
+    static int GetTypeBatch(const sol::table& component, int type_id);
+    
+    /**
+     * Calls one batched function of every component type that has it, with the type's live components
+     *
+     * @param   list        the list of each type to run
+     * @param   function    the batched function of each type to call
+     * @param   callback    the callback to report to the script profiler
+    */
+    static void RunTypeBatches(std::vector<ComponentRef> ComponentTypeBatch::* list, sol::protected_function ComponentTypeBatch::* function, SCRIPT_CALLBACK callback);
     
-public:
     //-------------------------------------------------------
-    // Lifecycle Functions
+    // Pooling
+    
+    inline static std::vector<ActorPool> pools; // See ActorBlueprint::pool_id
+    
+    // Instances of pooled actors destroyed this frame, they go back to their pools once the actors are destroyed
+    inline static std::vector<std::pair<int, std::vector<std::shared_ptr<sol::table>>>> pending_pool_returns;
     
     /**
-     * Cleans all of the dead actors out from the vectors
+     * Gives a new actor an ID and adds it to the actor vectors, with no components
+     *
+     * @param   blueprint    the blueprint of the actor, only its name and enabled state are read
+     * @returns              the id of the new actor
     */
-    static void Cleanup();
-
+    static int AllocateActor(const ActorBlueprint& blueprint);
+    
+    /**
+     * Sets the type, key, enabled state, and properties of a component from its blueprint
+     *
+     * @param   component    the component to set up
+     * @param   blueprint    the blueprint of the component
+    */
+    static void ApplyComponentBlueprint(sol::table& component, const ComponentBlueprint& blueprint);
+    
+    /**
+     * Creates a new component from its blueprint
+     *
+     * @param   blueprint    the blueprint of the component
+     * @param   actor_id     the id of the actor the component is on
+     * @returns              the new component
+    */
+    static std::shared_ptr<sol::table> CreateComponent(const ComponentBlueprint& blueprint, int actor_id);
+    
+    /**
+     * Resets a pooled component back to the values a new component would have
+     *
+     * @param   component    the component to reset, native components are replaced with a new one
+     * @param   blueprint    the blueprint of the component
+     * @param   actor_id     the id of the actor the component is on now
+    */
+    static void ResetComponent(std::shared_ptr<sol::table>& component, const ComponentBlueprint& blueprint, int actor_id);
+    
+    /**
+     * Gets the pool of a blueprint, making it the first time a pooled blueprint is used
+     *
+     * @param   blueprint    the blueprint of a template
+     * @returns              the index of the pool in "pools", -1 if the blueprint isn't pooled
+    */
+    static int GetPoolID(ActorBlueprint& blueprint);
+    
+    /**
+     * Creates an actor from an instance in a pool
+     *
+     * @param   pool_id    the pool to take the instance from, must have a free instance
+     * @returns            the id of the new actor
+    */
+    static int ReuseActor(int pool_id);
+    
+public:
+    //-------------------------------------------------------
+    // Lifecycle Functions
+    
     /**
      * Processes all components added to the actor on the previous frame
     */
@@ -90,6 +402,12 @@ public:
     */
     static void LateUpdate();
 
+    /**
+     * Calls "OnFixedUpdate" for every component that has it
+     * Called once per simulation step, which can be zero or several times in a single frame
+    */
+    static void FixedUpdate();
+
     /**
      * Processes all components removed from actors on this frame
     */
@@ -98,13 +416,44 @@ public:
     //-------------------------------------------------------
     // Getters/Setters
     
+    /**
+     * Gets the component whose lifecycle or collision function is running, coroutines started from it belong to it
+     *
+     * @returns    the running component, nullptr outside of those functions
+    */
+    static inline ComponentState* GetRunningComponent() { return running_component; }
+    
+    /**
+     * Sets the running component, for systems that run script code on a component's behalf (ex: Coroutines)
+     *
+     * @param   component    the component to run as, nullptr for none
+    */
+    static inline void SetRunningComponent(ComponentState* component) { running_component = component; }
+    
+    /**
+     * Gets the slot part of an actor ID
+     * Slots are small, dense, and unique among loaded actors, so other systems can use them to index their own per-actor vectors
+     *
+     * @param   actor_id    the id of the actor
+     * @returns             the slot of the given actor
+    */
+    static inline int GetSlot(int actor_id) { return actor_id & ACTOR_SLOT_MASK; }
+    
     /**
      * Returns this actors name
      *
      * @param   actor_id    the id of the actor that this function is acting on
-     * @returns             the name of the given actor
+     * @returns             the name of the given actor, empty if the actor doesn't exist
     */
-    static std::string GetName(int actor_id);
+    static const std::string& GetName(int actor_id);
+    
+    /**
+     * Returns the ID of this actors name in the StringTable
+     *
+     * @param   actor_id    the id of the actor that this function is acting on
+     * @returns             the name ID of the given actor, -1 if the actor doesn't exist
+    */
+    static int GetNameID(int actor_id);
 
     /**
      * Returns this actors ID
@@ -127,6 +476,44 @@ public:
     */
     static int LoadActorWithJSON(const rapidjson::Value& actor_data);
     
+    /**
+     * Creates a new actor from a compiled blueprint
+     * DO NOT USE: This function is for use inside of the scene and actor managers only.
+     * In order to create a new actor please use the "'instantiate' function instead
+     *
+     * @param   blueprint    the blueprint of the actor
+     * @return               returns the id of the newly created actor
+    */
+    static int LoadActorWithBlueprint(const ActorBlueprint& blueprint);
+    
+    /**
+     * Creates a new actor from a template
+     * If the template is pooled the actor is reused from its pool when one is free, otherwise it is loaded from JSON
+     * DO NOT USE: This function is for use inside of the scene and actor managers only.
+     * In order to create a new actor please use the "'instantiate' function instead
+     *
+     * @param   template_name    the name of the template
+     * @return                   returns the id of the newly created actor
+    */
+    static int LoadActorFromTemplate(const std::string& template_name);
+    
+    /**
+     * Creates many actors from a template at once, the same as calling LoadActorFromTemplate "count" times
+     * The blueprint and pool are looked up once and the actor vectors only grow once
+     * DO NOT USE: This function is for use inside of the scene and actor managers only.
+     * In order to create new actors please use the "'instantiate many' function instead
+     *
+     * @param   template_name    the name of the template
+     * @param   count            the number of actors to create
+     * @param   actor_ids        the ids of the new actors are added to the end of this
+    */
+    static void LoadActorsFromTemplate(const std::string& template_name, int count, std::vector<int>& actor_ids);
+    
+    /**
+     * Fills the pool of every template that sets "prewarm", so the first spawns during the game don't have to load from JSON
+    */
+    static void PrewarmPools();
+    
     /**
      * Loads the data from JSON into an existing lua value
      * DO NOT USE: This function is for use inside of the scene and actor managers only.
@@ -146,6 +533,14 @@ public:
     */
     static void PrepareActorForDestruction(int actor_id);
     
+    /**
+     * Prepares many actors for destruction later this frame in a single pass
+     * DO NOT USE: This function is for use inside of the scene and actor managers only.
+     *
+     * @param   actor_ids    the ids of the actors to prepare, ids of actors that don't exist are skipped
+    */
+    static void PrepareActorsForDestruction(const std::vector<int>& actor_ids);
+    
     /**
      * Destroys an actor
      * DO NOT USE: This function is for use inside of the scene and actor managers only.
@@ -155,6 +550,14 @@ public:
     */
     static void DestroyActor(int actor_id);
     
+    /**
+     * Destroys many actors at once
+     * DO NOT USE: This function is for use inside of the scene and actor managers only.
+     *
+     * @param   actor_ids    the ids of the actors to destroy, ids of actors that don't exist are skipped
+    */
+    static void DestroyActors(const std::vector<int>& actor_ids);
+    
     //-------------------------------------------------------
     // Components.
     
@@ -173,7 +576,25 @@ public:
      * @param   type        the type of component we're searching for
      * @return              the first component on the given actor with the given type, if none are found returns null
     */
-    static sol::table GetComponentByType(int actor_id, std::string type);
+    static sol::table GetComponentByType(int actor_id, std::string_view type);
+    
+    /**
+     * Same as GetComponentByType, but takes a type ID from GetComponentTypeID so no string has to be hashed
+     *
+     * @param   actor_id    the id of the actor that this function is acting on
+     * @param   type_id     the ID of the type of component we're searching for
+     * @return              the first component on the given actor with the given type, if none are found returns null
+    */
+    static sol::table GetComponentByTypeID(int actor_id, int type_id);
+    
+    /**
+     * Gets the ID of a component type, for code that searches for the same type often
+     * The ID stays the same for the whole run, so it can be looked up once and kept
+     *
+     * @param   type    the name of the component type
+     * @return          the ID of the component type
+    */
+    static int GetComponentTypeID(std::string_view type);
 
     /**
     * Gets the number of components that an actor has
@@ -191,6 +612,15 @@ public:
     * @return                       a sol table containing the component
     */
     static sol::table GetComponentByIndex(int actor_id, int component_index);
+    
+    /**
+    * Gets the record of a component by index
+    * 
+    * @param     actor_id           the id of the actor that this function is acting on
+    * @param     component_index    the index of the component
+    * @return                       the record of the component, nullptr if the component cannot be found
+    */
+    static ComponentState* GetComponentStateByIndex(int actor_id, int component_index);
 
     /**
     * Gets where or not an actor is enabled
@@ -199,6 +629,32 @@ public:
     * @return                a bool for whether or not the actor is enabled
     */
     static bool GetActorEnabled(int actor_id);
+    
+    /**
+    * Enables or disables an actor, the components of a disabled actor aren't updated
+    * 
+    * @param     actor_id    the id of the actor that this function is acting on
+    * @param     enabled     whether the actor should be enabled
+    */
+    static void SetActorEnabled(int actor_id, bool enabled);
+    
+    /**
+    * Enables or disables a component, disabled components aren't updated
+    * Components must be enabled and disabled through this instead of setting "enabled" on them
+    * 
+    * @param     actor_id     the id of the actor that this function is acting on
+    * @param     component    the component on the actor
+    * @param     enabled      whether the component should be enabled
+    */
+    static void SetComponentEnabled(int actor_id, sol::table component, bool enabled);
+    
+    /**
+    * Pauses or resumes "OnUpdate" for every component in an execution group (see "update_group")
+    * 
+    * @param     group      the name of the execution group
+    * @param     enabled    whether the group should run
+    */
+    static void SetUpdateGroupEnabled(const std::string& group, bool enabled);
 
     /**
      * Gets all of the components on the given actor with the given type if they exist.
@@ -207,7 +663,7 @@ public:
      * @param   type        the type of component we're searching for
      * @return              a list of all the components with the given type, if none are found returns null
     */
-    static sol::table GetComponentsByType(int actor_id, std::string type);
+    static sol::table GetComponentsByType(int actor_id, std::string_view type);
     
     /**
      * Gets the component on the given actor with the given key if it exists.
@@ -216,8 +672,22 @@ public:
      * @param   key         the key of the component we're searching for
      * @return              the component on the given actor with the given key, if none are found returns null
     */
-    static sol::table GetComponentByKey(int actor_id, std::string key);
+    static sol::table GetComponentByKey(int actor_id, std::string_view key);
     
 }; // Actors
 
+/**
+ * Makes a component the running component until the end of the enclosing scope, then puts back the one before it
+ * Usage: RunningComponentScope running_scope(state);
+ */
+class RunningComponentScope
+{
+private:
+    ComponentState* previous;
+    
+public:
+    inline explicit RunningComponentScope(ComponentState* component) : previous(Actors::GetRunningComponent()) { Actors::SetRunningComponent(component); }
+    inline ~RunningComponentScope() { Actors::SetRunningComponent(previous); }
+};
+
 #endif /* ActorManager_h */
@@ -18,6 +18,16 @@
 */
 void LoadSounds();
 
+/**
+ * Starts decoding all of the audio in the resources/audio directory on the worker pool
+*/
+void StartLoadingSounds();
+
+/**
+ * Waits for the audio started by StartLoadingSounds and adds it to the database
+*/
+void FinishLoadingSounds();
+
 /**
  * Get an audio clip based on the clips name
  *
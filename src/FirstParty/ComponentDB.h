@@ -24,4 +24,13 @@ void LoadComponentTypes();
 */
 std::shared_ptr<sol::table> GetComponentType(std::string component_name);
 
+/**
+ * Adds a component type to the database from Lua source instead of a file in resources/component_types
+ * Used by tools that build their scenes in memory (wolverine-bench)
+ *
+ * @param   type_name   the name of the component type, the source must define a global table with this name
+ * @param   source      the Lua source code of the component type
+*/
+void AddComponentType(const std::string& type_name, const std::string& source);
+
 #endif /* ComponentDB_h */
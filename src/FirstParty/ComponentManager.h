@@ -9,12 +9,45 @@
 #ifndef ComponentManager_h
 #define ComponentManager_h
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "sol/sol.hpp"
 
 #include "ComponentDB.h"
+#include "StringTable.h"
+
+/**
+ * A native (C++) component type, made by ComponentManager::RegisterNativeComponent
+ * The engine calls the lifecycle functions of native components through these instead of through Lua
+ */
+struct NativeComponentType
+{
+    std::string name;
+    int type_id = -1; // See StringTable
+    
+    sol::table (*create)() = nullptr; // Makes a new component of the type
+    void* (*get)(const sol::table& component) = nullptr; // Gets the C++ object of a component, it lives as long as the component's userdata does
+    
+    // nullptr if the class doesn't have the function
+    void (*on_start)(void* native) = nullptr;
+    void (*on_update)(void* native) = nullptr;
+    void (*on_destroy)(void* native) = nullptr;
+    void (*release)(void* native) = nullptr; // Frees engine resources that point at the component, called on removal even when "OnDestroy" is skipped
+};
 
 class ComponentManager
-{ 
+{
+private:
+    inline static std::vector<NativeComponentType> native_types; // Indexed by native type ID
+    inline static std::vector<int> native_type_ids; // Indexed by type ID (see StringTable), the native type ID of each type, -1 for Lua components
+    
+    /**
+     * @returns    the Lua state, the registry can't include LuaAPI.h since it includes this
+     */
+    static sol::state& GetLuaState();
+    
 public:
     /**
      * Establishes inheritance between two tables by setting one to be the metatable of the other
@@ -27,21 +60,95 @@ public:
     //-------------------------------------------------------
     // Native Components
     
+    /**
+     * Registers a C++ class as a native component type, giving it a native type ID and binding it to Lua as a usertype
+     * The members every component has (type, key, actor, enabled, REMOVED_FROM_ACTOR) and the lifecycle functions the class has are bound here
+     *
+     *  @param    name    the name of the component type, as it is written in scenes and templates
+     *  @param    args    the rest of the usertype's members, the same as sol::state::new_usertype
+     *  @returns          the usertype, more members can be added to it
+     */
+    template <typename T, typename... Args>
+    static sol::usertype<T> RegisterNativeComponent(const std::string& name, Args&&... args)
+    {
+        NativeComponentType native_type;
+        native_type.name = name;
+        native_type.type_id = StringTable::Intern(name);
+        native_type.create = []() -> sol::table { return sol::make_object(GetLuaState(), T()); };
+        native_type.get = [](const sol::table& component) -> void* { return &component.as<T&>(); };
+        
+        sol::usertype<T> usertype = GetLuaState().new_usertype<T>(name, std::forward<Args>(args)...);
+        usertype["type"] = &T::type;
+        usertype["key"] = &T::key;
+        usertype["actor"] = &T::actor;
+        usertype["enabled"] = &T::enabled;
+        usertype["REMOVED_FROM_ACTOR"] = &T::REMOVED_FROM_ACTOR;
+        
+        if constexpr (requires (T& component) { component.OnStart(); })
+        {
+            native_type.on_start = [](void* native) { static_cast<T*>(native)->OnStart(); };
+            usertype["OnStart"] = &T::OnStart;
+        }
+        if constexpr (requires (T& component) { component.OnUpdate(); })
+        {
+            native_type.on_update = [](void* native) { static_cast<T*>(native)->OnUpdate(); };
+            usertype["OnUpdate"] = &T::OnUpdate;
+        }
+        if constexpr (requires (T& component) { component.OnDestroy(); })
+        {
+            native_type.on_destroy = [](void* native) { static_cast<T*>(native)->OnDestroy(); };
+            usertype["OnDestroy"] = &T::OnDestroy;
+        }
+        if constexpr (requires (T& component) { component.Release(); })
+        {
+            native_type.release = [](void* native) { static_cast<T*>(native)->Release(); };
+        }
+        
+        if (native_type.type_id >= static_cast<int>(native_type_ids.size())) { native_type_ids.resize(native_type.type_id + 1, -1); }
+        native_type_ids[native_type.type_id] = static_cast<int>(native_types.size());
+        native_types.push_back(native_type);
+        
+        return usertype;
+    }
+    
     /**
      * Returns true if the given type is a C++ based component
      *
      *  @param    type    the type to confirm if its native or not
      *  @returns          true if the given type is a native component, and false otherwise
      */
-    static bool IsComponentTypeNative(std::string type);
+    static bool IsComponentTypeNative(std::string_view type);
+    
+    /**
+     * Gets the native type ID of a component type
+     *
+     *  @param    type_id    the ID of the component type (see StringTable)
+     *  @returns             the index of the type in the native registry, -1 for Lua components
+     */
+    static inline int GetNativeComponentType(int type_id)
+    {
+        if (type_id < 0 || type_id >= static_cast<int>(native_type_ids.size())) { return -1; }
+        return native_type_ids[type_id];
+    }
+    
+    /**
+     * @param    native_type    a native type ID (see GetNativeComponentType)
+     * @returns                 the registered native component type
+     */
+    static inline const NativeComponentType& GetNativeType(int native_type) { return native_types[native_type]; }
+    
+    /**
+     * @returns    the number of registered native component types, every native type ID is less than this
+     */
+    static inline int GetNativeTypeCount() { return static_cast<int>(native_types.size()); }
     
     /**
      * Creates and returns a new native component of the given type
      *
-     *  @param    component_type    the component type to create a new copy of
-     *  @returns                    the table that contains our new native component
+     *  @param    native_type    the native type ID of the component type to create a new copy of
+     *  @returns                 the table that contains our new native component
      */
-    static sol::table NewNativeComponent(std::string component_type);
+    static sol::table NewNativeComponent(int native_type);
 };
 
 #endif /* ComponentManager_h */
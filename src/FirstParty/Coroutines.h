@@ -0,0 +1,184 @@
+//
+//  Coroutines.h
+//  wolverine_engine
+//
+//  Runs Lua coroutines started by scripts, waking each one only when what it is waiting for happens
+//
+
+#ifndef Coroutines_h
+#define Coroutines_h
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sol/sol.hpp"
+
+struct ComponentState;
+
+/**
+ * What a coroutine yielded to wait for, the first value yielded by WaitFrames, WaitSeconds, and WaitUntilEvent
+ */
+enum COROUTINE_WAIT {
+    COROUTINE_WAIT_FRAMES,
+    COROUTINE_WAIT_SECONDS,
+    COROUTINE_WAIT_EVENT
+};
+
+/**
+ * A hashed timer wheel, holds coroutines until the tick they are due on
+ * Only the slots of the ticks that passed are looked at, so waiting coroutines cost nothing until they are due
+ */
+struct TimerWheel
+{
+    // Each slot holds every entry due on a tick that maps to it, along with the tick they are due on
+    // Entries more than one turn of the wheel away stay in their slot until their turn comes around
+    std::vector<std::vector<std::pair<long long, int>>> slots;
+    long long next_tick = 0; // Every tick before this has been processed
+
+    inline explicit TimerWheel(int num_slots) : slots(num_slots) {}
+
+    /**
+     * Adds an entry to the wheel
+     *
+     * @param    due_tick        the tick the entry is due on, entries due before the next tick are due on the next tick
+     * @param    coroutine_id    the coroutine waiting
+     * @returns                  the tick the entry was added on, for Remove
+     */
+    long long Add(long long due_tick, int coroutine_id);
+
+    /**
+     * Takes an entry out of the wheel before it is due, does nothing if it already came due
+     *
+     * @param    due_tick        the tick Add returned for the entry
+     * @param    coroutine_id    the coroutine waiting
+     */
+    void Remove(long long due_tick, int coroutine_id);
+
+    /**
+     * Takes every entry due on or before a tick out of the wheel
+     *
+     * @param    tick    the current tick
+     * @param    due     the coroutines that are due are added to the end of this
+     */
+    void Advance(long long tick, std::vector<int>& due);
+};
+
+/**
+ * A coroutine started with Engine.StartCoroutine
+ */
+struct CoroutineRecord
+{
+    sol::thread thread; // Keeps the coroutine's Lua thread alive
+    sol::coroutine routine;
+
+    // The component that started the coroutine, the coroutine is stopped once the component is removed
+    // Coroutines started outside of a component's lifecycle functions have no owner and run until they finish
+    std::weak_ptr<ComponentState> owner;
+    bool has_owner = false;
+
+    bool running = false; // True while the coroutine is being resumed
+    bool stopped = false; // Set by Engine.StopCoroutine while the coroutine is running, it is removed once it yields
+
+    // Where the coroutine is waiting, so it can be taken out of the wheel or event list if it is stopped before it is due
+    bool waiting = false;
+    COROUTINE_WAIT wait = COROUTINE_WAIT_FRAMES;
+    long long due_tick = 0; // The tick in the wheel for frame and time waits
+    int event_id = -1; // See StringTable, for event waits
+};
+
+class Coroutines
+{
+private:
+    inline static std::unordered_map<int, CoroutineRecord> coroutines; // Coroutine handle -> coroutine
+    inline static int next_id = 1;
+
+    inline static TimerWheel frame_wheel = TimerWheel(256); // Ticks are frames
+    inline static TimerWheel time_wheel = TimerWheel(256); // Ticks are 1/64 of a second of game time
+    inline static constexpr double time_ticks_per_second = 64.0;
+
+    inline static std::unordered_map<int, std::vector<int>> event_waiters; // Event name ID (see StringTable) -> the coroutines waiting for it
+    inline static std::vector<int> ready; // Coroutines to resume the next time Update runs, in order
+    inline static std::vector<int> resuming; // The coroutines being resumed this frame, kept between frames so its storage is reused
+
+    // The number of times Update has finished, coroutines waiting from this frame count from the next time Update runs
+    // Counted here instead of using the engine's frame number so a wait always ends on a later Update, whether it started before or during this frame's
+    inline static long long frame = 0;
+
+    /**
+     * Resumes a coroutine that is due, unless it was stopped or its owner was removed
+     *
+     * @param    coroutine_id    the handle of the coroutine
+     */
+    static void Resume(int coroutine_id);
+
+    /**
+     * Puts a coroutine that was just resumed in the wheel or event list for what it yielded, or removes it if it finished
+     *
+     * @param    coroutine_id    the handle of the coroutine
+     * @param    result          what resuming the coroutine returned
+     */
+    static void Schedule(int coroutine_id, const sol::protected_function_result& result);
+
+    /**
+     * Throws a coroutine away, taking it out of whatever it is waiting for and its owner's list of coroutines
+     * Coroutines that are running can't be thrown away until they yield, see CoroutineRecord::stopped
+     *
+     * @param    found    the coroutine
+     */
+    static void Erase(std::unordered_map<int, CoroutineRecord>::iterator found);
+
+    /**
+     * Prints an error from a coroutine
+     *
+     * @param    record     the coroutine
+     * @param    message    the error
+     */
+    static void PrintError(const CoroutineRecord& record, const std::string& message);
+
+public:
+    /**
+     * Resumes every coroutine that is due this frame, call once per frame after the components update
+     */
+    static void Update();
+
+    /**
+     * Starts a coroutine, it runs right away until it first waits
+     * If called from a component's lifecycle function the coroutine belongs to that component, and is stopped once the component is removed
+     *
+     * @param    function    the function to run as a coroutine
+     * @param    args        passed to the function
+     * @returns              the handle of the coroutine, for Engine.StopCoroutine
+     */
+    static int StartCoroutine(sol::function function, sol::variadic_args args);
+
+    /**
+     * Stops a coroutine, it is never resumed again
+     *
+     * @param    coroutine_id    the handle of the coroutine, handles of coroutines that already finished are ignored
+     */
+    static void StopCoroutine(int coroutine_id);
+
+    /**
+     * Stops every coroutine a component started, called once the component is removed
+     *
+     * @param    component    the component
+     */
+    static void StopComponentCoroutines(ComponentState& component);
+
+    /**
+     * Wakes every coroutine waiting for an event, they are resumed the next time Update runs (this frame if it hasn't yet)
+     *
+     * @param    event_name    the name of the event
+     */
+    static void RaiseEvent(const std::string& event_name);
+
+    /**
+     * @returns    the number of coroutines that haven't finished
+     */
+    static inline int GetCount() { return static_cast<int>(coroutines.size()); }
+};
+
+#endif /* Coroutines_h */
@@ -18,6 +18,7 @@
 #include "LuaAPI.h"
 #include "CollisionDetector.h"
 #include "PhysicsWorld.h"
+#include "TimeManager.h"
 
 using namespace std;
 
@@ -28,8 +29,28 @@ struct EngineData
     */
     static bool quit;
     inline static std::string game_title = "";
+    
+    inline static bool headless = false; // True if running without a window, renderer, or audio (--headless)
+    inline static int max_frames = 0; // The game quits after this many frames, 0 means run until quit (--frames N)
+    inline static int frames_run = 0; // The number of frames that have been completed
+    
+    inline static std::string record_path = ""; // Input is recorded to this file if it isn't empty (--record path)
+    inline static std::string replay_path = ""; // Input is played back from this file instead of the player if it isn't empty (--replay path)
+    inline static bool has_random_seed = false; // True if the random seed was given on the command line (--seed N)
+    inline static uint32_t random_seed = 0;
+    
+    inline static std::string trace_path = ""; // A Chrome trace of the run is written to this file if it isn't empty (--trace path)
 }; // EngineData
 
+/**
+ * Reads the command line arguments into EngineData
+ * Accepts `--headless`, `--frames N`, `--record path`, `--replay path`, `--seed N`, and `--trace path`
+ *
+ * @param    argc    the number of arguments
+ * @param    argv    the arguments given to main
+ */
+void ParseCommandLine(int argc, char* argv[]);
+
 /**
  * Called from the main function. Starts the game.
 */
@@ -49,7 +70,10 @@ int CheckConfigFiles();
 
 /**
  * resources/game.config accepts fields:
- * `game_title` and `initial_scene`
+ * `game_title`, `initial_scene`, `fixed_updates_per_second`, `max_fixed_steps_per_frame`,
+ * `profiler`, `profiler_history_frames`, `profiler_font`, `profiler_report`,
+ * `script_profiler`, `script_profiler_report_frames`, `script_profiler_top`, `lua_memory_budget_mb`,
+ * `lua_gc_mode`, `lua_gc_step_budget_ms`, and `lua_gc_step_kb`
  */
 bool CheckGameConfig();
 
@@ -61,12 +85,15 @@ bool CheckGameConfig();
 int GameLoop();
 
 /**
-* Initializes the collision detection for the b2world
+* Initializes the collision detection for the b2world if it hasn't been already
 * 
 * NOTE: can't be called from PhysicsWorld bc CollisionDetector would have to be included
 */
 inline static void InitializeCollisions() {
-	PhysicsWorld::collision_detector = new CollisionDetector();
+    if (PhysicsWorld::collision_detector != nullptr)
+        return;
+
+    PhysicsWorld::collision_detector = new CollisionDetector();
     PhysicsWorld::world->SetContactListener(PhysicsWorld::collision_detector);
 }
 
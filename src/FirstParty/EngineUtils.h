@@ -23,9 +23,12 @@
 class EngineUtils {
 public:
     /**
-     * Reads a json file located at `path` into `out_document`
+     * Parses a json file located at `path` into `out_document`, without exiting on an error
+     * Safe to call from the worker pool, the caller reports the error on the main thread
+     *
+     * @returns    true if the file was parsed
      */
-    static void ReadJsonFile(const std::string& path, rapidjson::Document& out_document) {
+    static bool ParseJsonFile(const std::string& path, rapidjson::Document& out_document) {
         FILE* file_pointer = nullptr;
     #ifdef _WIN32
         fopen_s(&file_pointer, path.c_str(), "rb");
@@ -37,7 +40,14 @@ public:
         out_document.ParseStream(stream);
         std::fclose(file_pointer);
 
-        if (out_document.HasParseError()) {
+        return !out_document.HasParseError();
+    }
+
+    /**
+     * Reads a json file located at `path` into `out_document`
+     */
+    static void ReadJsonFile(const std::string& path, rapidjson::Document& out_document) {
+        if (!ParseJsonFile(path, out_document)) {
             std::cout << "error parsing json at [" << path << "]";
             exit(0);
         }
@@ -78,15 +88,16 @@ public:
                         
                         CombineJsonDocuments(lhs, rhs, array);
                         
-                        out_document.AddMember(json_member_name, array, array.GetAllocator());
+                        // Copied into out_document's allocator, "array" frees its own memory when it goes out of scope
+                        rapidjson::Value combined(array, out_document.GetAllocator());
+                        out_document.AddMember(json_member_name, combined, out_document.GetAllocator());
                     }
                 }
                 else
                 {
                     // Otherwise, just add the d2 array
-                    rapidjson::Document array;
-                    array.CopyFrom(d2[member_name.c_str()], d2.GetAllocator());
-                    out_document.AddMember(json_member_name, array, array.GetAllocator());
+                    rapidjson::Value array(d2[member_name.c_str()], out_document.GetAllocator());
+                    out_document.AddMember(json_member_name, array, out_document.GetAllocator());
                 }
             }
             else if (itr->value.IsBool())
@@ -149,9 +160,8 @@ public:
             // Add each unique object from d1 into out_document
             if (itr->value.IsObject())
             {
-                rapidjson::Document array;
-                array.CopyFrom(d1[member_name.c_str()], d1.GetAllocator());
-                out_document.AddMember(json_member_name, array, array.GetAllocator());
+                rapidjson::Value array(d1[member_name.c_str()], out_document.GetAllocator());
+                out_document.AddMember(json_member_name, array, out_document.GetAllocator());
             }
             else if (itr->value.IsBool())
             {
@@ -194,8 +204,7 @@ public:
     static float RandomNumber(float min, float max, int precision)
     {
         // Random number engine
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        std::mt19937& gen = random_engine;
         
         int r_min = min * precision;
         int r_max = max * precision;
@@ -207,6 +216,31 @@ public:
         float num = dis(gen) / (float)precision;
         return num;
     }
+    
+    /**
+     * Restarts the random number generator from a seed.
+     * The same seed always gives the same sequence of random numbers, which replays rely on.
+     *
+     * @param   seed    the new seed
+     */
+    static void SeedRandom(uint32_t seed)
+    {
+        random_seed = seed;
+        random_engine.seed(seed);
+    }
+    
+    /**
+     * @returns    the seed the random number generator was last started from
+     */
+    static uint32_t GetRandomSeed()
+    {
+        return random_seed;
+    }
+    
+private:
+    // Seeded once at startup instead of on every call so runs can be repeated with SeedRandom
+    inline static uint32_t random_seed = std::random_device{}();
+    inline static std::mt19937 random_engine{random_seed};
 };
 
 #endif /* EngineUtils_h */
@@ -19,6 +19,17 @@
 */
 void LoadImages();
 
+/**
+ * Starts decoding all of the images in the resources/images directory on the worker pool
+*/
+void StartLoadingImages();
+
+/**
+ * Waits for the images started by StartLoadingImages and turns them into textures
+ * Must be called on the main thread after the renderer has been initialized
+*/
+void FinishLoadingImages();
+
 /**
  * Get an image based on the images name
  *
@@ -27,4 +38,13 @@ void LoadImages();
 */
 SDL_Texture* GetImage(std::string image_name);
 
+/**
+ * Adds an image to the database without loading it from resources/images
+ * Used by tools that build their scenes in memory (wolverine-bench)
+ *
+ * @param    image_name    the name the image can be found with
+ * @param    image         the texture to store, can be nullptr when headless
+ */
+void AddImage(const std::string& image_name, SDL_Texture* image);
+
 #endif /* ImageDB_h */
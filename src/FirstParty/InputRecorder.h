@@ -0,0 +1,120 @@
+//
+//  InputRecorder.h
+//  wolverine_engine
+//
+//  Records the input events of a session to a file and plays them back frame for frame
+//
+
+#ifndef InputRecorder_h
+#define InputRecorder_h
+
+#include <string>
+#include <vector>
+
+#include "SDL.h"
+
+/**
+ * The kinds of records stored in a recording
+ */
+enum INPUT_RECORD {
+    INPUT_RECORD_FRAME, // Starts a new frame: frame index (u32), unscaled frame length in seconds (f32)
+    INPUT_RECORD_KEY_DOWN, // scancode (u16)
+    INPUT_RECORD_KEY_UP, // scancode (u16)
+    INPUT_RECORD_MOUSE_DOWN, // SDL mouse button (u8)
+    INPUT_RECORD_MOUSE_UP, // SDL mouse button (u8)
+    INPUT_RECORD_MOUSE_WHEEL, // precise y scroll (f32)
+    INPUT_RECORD_MOUSE_MOTION // x (i32), y (i32)
+};
+
+/**
+ * Everything that happened during one recorded frame
+ */
+struct RecordedFrame
+{
+    float delta_time = 0.0f; // The unscaled length of the frame in seconds
+    std::vector<SDL_Event> events; // The input events in the order they were processed
+};
+
+class InputRecorder
+{
+private:
+    inline static SDL_RWops* record_file = nullptr; // The recording being written, nullptr when not recording
+    inline static std::vector<RecordedFrame> replay_frames; // Every frame of the recording being played back
+    inline static bool replaying = false;
+
+public:
+    /**
+     * Starts writing every input event to a file.
+     * The random seed is stored in the file so the replay makes the same random numbers.
+     *
+     * @param    path    the file to write the recording to
+     * @returns          true if the file could be opened
+     */
+    static bool StartRecording(const std::string& path);
+
+    /**
+     * Loads a recording and starts feeding it to Input instead of the live events.
+     * Seeds the random number generator with the seed the recording was made with.
+     *
+     * @param    path    the recording to play back
+     * @returns          true if the recording could be read
+     */
+    static bool StartReplay(const std::string& path);
+
+    /**
+     * Closes the recording file, call before the game exits
+     */
+    static void Finish();
+
+    /**
+     * While replaying, makes the frame the same length as it was when it was recorded.
+     * Call right before Time::BeginFrame.
+     *
+     * @param    frame    the index of the frame that is starting
+     */
+    static void ApplyReplayFrame(const int frame);
+
+    /**
+     * While recording, starts a new frame in the recording.
+     * Call right after Time::BeginFrame.
+     *
+     * @param    frame         the index of the frame that is starting
+     * @param    delta_time    the unscaled length of the frame in seconds
+     */
+    static void RecordFrame(const int frame, const float delta_time);
+
+    /**
+     * While recording, adds an event to the current frame if it is one that Input uses
+     *
+     * @param    e    the event taken from the SDL event queue
+     */
+    static void RecordEvent(const SDL_Event& e);
+
+    /**
+     * While replaying, sends all of the events recorded for this frame to Input
+     *
+     * @param    frame    the index of the current frame
+     */
+    static void ReplayEvents(const int frame);
+
+    //-------------------------------------------------------
+    // Getters/Setters
+
+    /**
+     * @returns    true if input is coming from a recording instead of the player
+     */
+    static inline bool IsReplaying() { return replaying; }
+
+    /**
+     * @returns    true if input is being written to a recording
+     */
+    static inline bool IsRecording() { return record_file != nullptr; }
+
+    /**
+     * @param    frame    the index of the frame that is about to start
+     * @returns           true if a replay is running and it has no frames left
+     */
+    static inline bool IsReplayFinished(const int frame) { return replaying && frame >= static_cast<int>(replay_frames.size()); }
+};
+
+#endif /* InputRecorder_h */
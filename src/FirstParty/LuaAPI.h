@@ -15,6 +15,7 @@
 
 #include "ActorManager.h"
 #include "InputManager.h"
+#include "TimeManager.h"
 #include "Renderer.h"
 #include "RenderRequests.h"
 #include "AudioManager.h"
@@ -24,15 +25,17 @@
 #include "CollisionDetector.h"
 #include "SpriteRenderer.h"
 #include "ParticleSystem.h"
+#include "LuaAllocator.h"
 
 class LuaAPI
 {
 public:
 	/**
 	* Initializes the Lua state
+	* All of the state's memory goes through LuaAllocator so the heap can be measured and capped
 	*/
 	static inline void InitLuaState() {
-		l_state = new sol::state();
+		l_state = new sol::state(sol::default_at_panic, &LuaAllocator::Allocate);
 		l_state->open_libraries(sol::lib::base, sol::lib::package, sol::lib::table);
 	}
 
@@ -82,7 +85,7 @@ private:
 	static void LogError(const std::string& message);
 
 	/**
-	* Quits the application.
+	* Quits the application at the end of the current frame.
 	* Used in the Lua API Application namespace
 	*/
 	static void Quit();
@@ -0,0 +1,112 @@
+//
+//  LuaAllocator.h
+//  wolverine_engine
+//
+//  The allocator given to the Lua state, keeps track of how much memory the scripts are using and can cap it
+//
+
+#ifndef LuaAllocator_h
+#define LuaAllocator_h
+
+#include <stddef.h>
+
+#include <string>
+
+#include "sol/sol.hpp"
+
+// Allocations are counted in power of two size classes, from 16 bytes and under up to anything over 4 KB
+enum LUA_SIZE_CLASS {
+    LUA_SIZE_CLASS_16,
+    LUA_SIZE_CLASS_32,
+    LUA_SIZE_CLASS_64,
+    LUA_SIZE_CLASS_128,
+    LUA_SIZE_CLASS_256,
+    LUA_SIZE_CLASS_512,
+    LUA_SIZE_CLASS_1K,
+    LUA_SIZE_CLASS_2K,
+    LUA_SIZE_CLASS_4K,
+    LUA_SIZE_CLASS_LARGE,
+    LUA_SIZE_CLASS_COUNT
+};
+
+class LuaAllocator
+{
+private:
+    inline static size_t live_bytes = 0; // Bytes currently held by the Lua state
+    inline static size_t peak_bytes = 0; // The most live_bytes has ever been
+    inline static size_t budget_bytes = 0; // Allocations that would go over this fail, 0 means no limit
+
+    inline static unsigned long long total_allocations = 0; // New blocks and blocks that grew
+    inline static unsigned long long total_frees = 0;
+    inline static unsigned long long failed_allocations = 0; // Allocations refused because of the budget
+
+    inline static int frame_allocations = 0; // Allocations made so far this frame
+    inline static int last_frame_allocations = 0; // Allocations made during the last full frame
+    inline static size_t frame_allocated_bytes = 0;
+    inline static size_t last_frame_allocated_bytes = 0;
+
+    inline static unsigned long long size_class_counts[LUA_SIZE_CLASS_COUNT] = {};
+
+    /**
+     * @param    size    the size of an allocation in bytes
+     * @returns          the size class the allocation is counted in
+     */
+    static LUA_SIZE_CLASS GetSizeClass(const size_t size);
+
+public:
+    /**
+     * The lua_Alloc function given to the Lua state
+     * Follows the lua_Alloc contract: frees when nsize is 0, and never fails when a block shrinks
+     *
+     * @param    ud       unused
+     * @param    ptr      the block being resized or freed, null for a new block
+     * @param    osize    the old size of the block, or the type of object being made when ptr is null
+     * @param    nsize    the new size of the block
+     * @returns           the resized block, or null when it was freed or couldn't be allocated
+     */
+    static void* Allocate(void* ud, void* ptr, size_t osize, size_t nsize);
+
+    /**
+     * Moves this frame's allocation counts into the last frame's, call once at the start of every frame
+     */
+    static void BeginFrame();
+
+    /**
+     * Sets the most memory the Lua state is allowed to use
+     * Allocations that would go over the budget fail and Lua raises a "not enough memory" error in the script that made them
+     *
+     * @param    bytes    the budget in bytes, 0 removes the budget
+     */
+    static void SetBudget(const size_t bytes);
+
+    /**
+     * @returns    a table with the current memory stats, given to Lua as Debug.GetMemoryStats
+     */
+    static sol::table GetStats();
+
+    /**
+     * @returns    a one line summary of the Lua heap for the profiler overlay
+     */
+    static std::string GetSummary();
+
+    /**
+     * @param    size_class    the size class to get the name of
+     * @returns                the name of the size class, ex: "<=64"
+     */
+    static const char* GetSizeClassName(const LUA_SIZE_CLASS size_class);
+
+    //-------------------------------------------------------
+    // Getters
+
+    static inline size_t GetLiveBytes() { return live_bytes; }
+    static inline size_t GetPeakBytes() { return peak_bytes; }
+    static inline size_t GetBudget() { return budget_bytes; }
+    static inline unsigned long long GetTotalAllocations() { return total_allocations; }
+    static inline unsigned long long GetTotalFrees() { return total_frees; }
+    static inline unsigned long long GetFailedAllocations() { return failed_allocations; }
+    static inline int GetLastFrameAllocations() { return last_frame_allocations; }
+    static inline size_t GetLastFrameAllocatedBytes() { return last_frame_allocated_bytes; }
+    static inline unsigned long long GetSizeClassCount(const LUA_SIZE_CLASS size_class) { return size_class_counts[size_class]; }
+};
+
+#endif /* LuaAllocator_h */
@@ -0,0 +1,74 @@
+//
+//  LuaGC.h
+//  wolverine_engine
+//
+//  Takes control of Lua's garbage collector so collection happens after the frame is presented instead of in the middle of a script
+//
+
+#ifndef LuaGC_h
+#define LuaGC_h
+
+#include <stddef.h>
+
+#include <string>
+
+#include "SDL.h"
+
+enum LUA_GC_MODE {
+    LUA_GC_MODE_AUTOMATIC, // Lua collects whenever allocating triggers it, the engine doesn't step it
+    LUA_GC_MODE_INCREMENTAL, // The engine runs incremental slices in the time left after present
+    LUA_GC_MODE_GENERATIONAL // The engine runs a minor collection after present once the heap has grown enough
+};
+
+class LuaGC
+{
+private:
+    inline static LUA_GC_MODE mode = LUA_GC_MODE_AUTOMATIC;
+    inline static double step_budget_ms = 1.0; // The most time spent collecting after each frame, unless the heap has to catch up
+    inline static int step_kb = 16; // How much work each slice does, smaller slices keep closer to the budget
+
+    // A new incremental cycle starts once the heap grows this much past its size after the last finished cycle
+    // Matches Lua's default pause of 200%
+    inline static double pause_multiplier = 2.0;
+    // Once the heap grows this much past its size after the last finished cycle, slices ignore the budget until the cycle finishes
+    inline static double catch_up_multiplier = 4.0;
+    // In generational mode, a minor collection runs once the heap grows this much past its size after the last one
+    // Matches Lua's default minor multiplier of 20%
+    inline static double minor_multiplier = 1.2;
+
+    inline static size_t bytes_after_collection = 0; // The size of the heap after the last finished cycle or minor collection
+    inline static bool in_cycle = false; // True while an incremental cycle is being worked through
+
+    inline static Uint64 step_budget_ticks = 0; // The step budget in performance counter ticks
+
+public:
+    /**
+     * Sets up the collector, called once the Lua state exists and the config has been read
+     *
+     * @param    new_mode              who runs the collector and how
+     * @param    new_step_budget_ms    the most time spent collecting after each frame
+     * @param    new_step_kb           how much work each slice does
+     */
+    static void Init(const LUA_GC_MODE new_mode, const double new_step_budget_ms, const int new_step_kb);
+
+    /**
+     * Runs collection for up to the step budget, call once per frame after the frame is presented
+     */
+    static void Step();
+
+    /**
+     * Finishes the current cycle and collects everything that can be collected
+     * Used while a scene loads, where a hitch isn't noticed
+     */
+    static void FullCollect();
+
+    /**
+     * @param    name    the name of a mode as written in game.config ("automatic", "incremental", or "generational")
+     * @returns          the mode, or LUA_GC_MODE_INCREMENTAL if the name isn't known
+     */
+    static LUA_GC_MODE GetModeFromName(const std::string& name);
+
+    static inline LUA_GC_MODE GetMode() { return mode; }
+};
+
+#endif /* LuaGC_h */
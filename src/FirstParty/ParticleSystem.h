@@ -19,6 +19,7 @@
 #include "Renderer.h"
 #include "EngineUtils.h"
 #include "ImageDB.h"
+#include "TimeManager.h"
 
 using namespace std;
 
@@ -40,11 +41,12 @@ class ParticleSystem
 public:
     int MAX_NUM_PARTICLES = 1000;
     int num_particles = 0;
-    int framesActive = 0; // The number of frames that this system has been emitting for.
+    float time_active = 0.0f; // The number of seconds that this system has been emitting for.
+    float emission_accumulator = 0.0f; // Particles that are owed by the emission rate but haven't been spawned yet.
     std::queue<Particle*> particles;
     
     // Base component values
-    std::string type = "Rigidbody";
+    std::string type = "ParticleSystem";
     std::string key = "???";
     Actor* actor = nullptr;
     bool REMOVED_FROM_ACTOR = false;
@@ -115,8 +117,8 @@ public:
     void StartEmitting();
     void StopEmitting();
     void CreateParticle();
-    void UpdateParticle(Particle* particle);
-    std::vector<float> GetDeltaColor(Particle* particle);
+    void UpdateParticle(Particle* particle, float delta_time);
+    std::vector<float> GetDeltaColor(Particle* particle, float delta_time);
     b2FixtureDef* GetNewCollider(float size);
     void DestroyParticle(Particle* particle);
     void RenderParticle(Particle* particle);
@@ -11,9 +11,21 @@
 
 #include "box2d/box2d.h"
 #include "Renderer.h"
+#include "TimeManager.h"
+#include "Tracer.h"
 
 class CollisionDetector;
 
+/**
+ * The transform of a body at the end of the previous simulation step.
+ * Bodies that want to be drawn smoothly between simulation steps store a pointer to one of these in their user data.
+ */
+struct BodyInterpolation
+{
+    b2Vec2 previous_position = b2Vec2(0.0f, 0.0f);
+    float previous_angle = 0.0f;
+};
+
 // Used to draw the rigidbody colliders for debugging
 // No comments because none of this needs to be exposed to devs using the engine
 class DebugDraw : public b2Draw
@@ -63,7 +75,6 @@ public:
 	inline static bool world_initialized = false;
 	inline static CollisionDetector* collision_detector;
 	inline static b2World* world;
-	inline static float time_step = 1.0f / 60.0f;
     inline static DebugDraw ddraw;
 
 	/**
@@ -84,11 +95,25 @@ public:
 	};
 
 	/**
-	* advances the b2World by the specified time step
+	* advances the b2World by a single fixed time step
 	*/
 	inline static void AdvanceWorld() {
-		if (PhysicsWorld::world_initialized)
-			PhysicsWorld::world->Step(1.0f / 60.0f, 8, 3);
+		if (!PhysicsWorld::world_initialized)
+			return;
+
+		// Remember where every interpolated body was before the step so that rendering can blend between the two
+		for (b2Body* body = PhysicsWorld::world->GetBodyList(); body != nullptr; body = body->GetNext())
+		{
+			BodyInterpolation* interpolation = reinterpret_cast<BodyInterpolation*>(body->GetUserData().pointer);
+			if (interpolation == nullptr)
+				continue;
+
+			interpolation->previous_position = body->GetPosition();
+			interpolation->previous_angle = body->GetAngle();
+		}
+
+		TRACE_ZONE("physics", "b2World::Step");
+		PhysicsWorld::world->Step(Time::GetFixedDeltaTime(), 8, 3);
 	};
 };
 
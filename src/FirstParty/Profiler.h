@@ -0,0 +1,239 @@
+//
+//  Profiler.h
+//  wolverine_engine
+//
+//  Times each phase of the frame and keeps a rolling history of the results
+//
+
+#ifndef Profiler_h
+#define Profiler_h
+
+#include <string>
+#include <vector>
+
+#include "SDL.h"
+#include "Tracer.h"
+
+/**
+ * Every part of the frame that the profiler keeps track of
+ */
+enum PROFILER_PHASE {
+    PROFILER_PHASE_FRAME,
+    PROFILER_PHASE_EVENTS,
+    PROFILER_PHASE_FIXED_UPDATE,
+    PROFILER_PHASE_PHYSICS,
+    PROFILER_PHASE_UPDATE_ACTORS,
+    PROFILER_PHASE_ADDED_COMPONENTS,
+    PROFILER_PHASE_UPDATE,
+    PROFILER_PHASE_COROUTINES,
+    PROFILER_PHASE_LATE_UPDATE,
+    PROFILER_PHASE_REMOVED_COMPONENTS,
+    PROFILER_PHASE_DESTROY_ACTORS,
+    PROFILER_PHASE_RENDER_IMAGES,
+    PROFILER_PHASE_RENDER_TEXT,
+    PROFILER_PHASE_RENDER_PIXELS,
+    PROFILER_PHASE_RENDER_LINES,
+    PROFILER_PHASE_RENDER_UI,
+    PROFILER_PHASE_PRESENT,
+    PROFILER_PHASE_LUA_GC,
+    PROFILER_PHASE_LOAD_SCENE,
+    PROFILER_PHASE_COUNT
+};
+
+class Profiler
+{
+private:
+    inline static bool enabled = false; // Nothing is recorded unless this is true
+    inline static bool overlay_visible = false; // True if the bar graph should be drawn on top of the game
+
+    inline static double counter_to_ms = 0.0; // Converts performance counter ticks to milliseconds
+
+    // The last N frames of timings in milliseconds
+    // Frame i, phase p is stored at history[i * PROFILER_PHASE_COUNT + p]
+    inline static std::vector<float> history;
+    inline static int history_frames = 300; // The number of frames kept in the history
+    inline static int current_frame = 0; // The index in the history of the frame being recorded, or the next one to be recorded between frames
+    inline static int frames_recorded = 0; // The number of finished frames in the history
+    inline static bool frame_open = false; // True between BeginFrame and EndFrame, samples taken outside of a frame are dropped
+
+    // How long each stage of Initialize took, recorded whether or not the profiler is enabled
+    inline static std::vector<std::pair<const char*, float>> startup_stages;
+
+    inline static std::string overlay_font = ""; // The font used to draw the overlay
+    inline static std::string report_path = "profile.csv"; // Where the report is written when the game closes
+
+public:
+    /**
+     * Must be called before the first frame if profiling is wanted
+     *
+     * @param    num_history_frames    how many frames of timings to keep around
+     */
+    static void Init(const int num_history_frames);
+
+    /**
+     * Starts recording a new frame, overwriting the oldest one in the history
+     */
+    static void BeginFrame();
+
+    /**
+     * Finishes the frame being recorded, it is included in the overlay and the report from now on
+     */
+    static void EndFrame();
+
+    /**
+     * Adds time to a phase of the current frame.
+     * Phases that run more than once in a frame (physics steps, etc.) add up.
+     *
+     * @param    phase       the phase that the time was spent in
+     * @param    start       the performance counter value when the phase started
+     * @param    end         the performance counter value when the phase ended
+     */
+    static void AddSample(const PROFILER_PHASE phase, const Uint64 start, const Uint64 end);
+
+    /**
+     * Queues the bar graph overlay into the text render queue, if the overlay is visible
+     */
+    static void DrawOverlay();
+
+    /**
+     * Writes the min, average, and 99th percentile of every phase over the recorded history to a CSV file
+     */
+    static void WriteReport();
+
+    /**
+     * Records how long a stage of startup took
+     *
+     * @param    name     the name of the stage, must point to a string that lives for the whole run
+     * @param    start    the performance counter value when the stage started
+     * @param    end      the performance counter value when the stage ended
+     */
+    static void AddStartupStage(const char* name, const Uint64 start, const Uint64 end);
+
+    /**
+     * Prints how long each stage of startup took, and how long startup took in total
+     *
+     * @param    total_ms    the wall time of the whole startup in milliseconds
+     */
+    static void PrintStartupReport(const float total_ms);
+
+    //-------------------------------------------------------
+    // Getters/Setters
+
+    /**
+     * @returns    true if the profiler is recording
+     */
+    static inline bool IsEnabled() { return enabled; }
+
+    /**
+     * Shows or hides the bar graph overlay
+     *
+     * @param    visible    true to show the overlay
+     */
+    static void SetOverlayVisible(const bool visible);
+
+    /**
+     * Flips the bar graph overlay between shown and hidden
+     */
+    static void ToggleOverlay();
+
+    /**
+     * Sets the font that the overlay is drawn with
+     *
+     * @param    font_name    the name of a font in resources/fonts
+     */
+    static void SetOverlayFont(const std::string& font_name);
+
+    /**
+     * Sets the file that the report is written to when the game closes
+     *
+     * @param    path    the path of the CSV file
+     */
+    static void SetReportPath(const std::string& path);
+
+    /**
+     * Gets the name of a phase, used for the overlay and the report
+     *
+     * @param    phase    the phase to get the name of
+     * @returns           the name of the phase
+     */
+    static const char* GetPhaseName(const PROFILER_PHASE phase);
+
+    /**
+     * Gets the average time spent in a phase over the last few frames
+     *
+     * @param    phase         the phase to average
+     * @param    num_frames    how many of the most recent frames to average over
+     * @returns                the average time in milliseconds
+     */
+    static float GetAverage(const PROFILER_PHASE phase, int num_frames);
+};
+
+/**
+ * Times everything between its creation and the end of the enclosing scope
+ * Also shows up as a zone in the trace when tracing
+ * Usage: ProfileScope scope(PROFILER_PHASE_UPDATE);
+ */
+class ProfileScope
+{
+private:
+    PROFILER_PHASE phase;
+    Uint64 start = 0;
+#ifdef WOLVERINE_TRACING
+    TraceZone trace_zone;
+#endif
+
+public:
+#ifdef WOLVERINE_TRACING
+    inline explicit ProfileScope(const PROFILER_PHASE phase) : phase(phase), trace_zone("frame", Profiler::GetPhaseName(phase))
+#else
+    inline explicit ProfileScope(const PROFILER_PHASE phase) : phase(phase)
+#endif
+    {
+        if (Profiler::IsEnabled()) { start = SDL_GetPerformanceCounter(); }
+    }
+
+    inline ~ProfileScope()
+    {
+        if (Profiler::IsEnabled()) { Profiler::AddSample(phase, start, SDL_GetPerformanceCounter()); }
+    }
+};
+
+/**
+ * Records a frame in the profiler's history between its creation and the end of the enclosing scope
+ * Declared before the frame's ProfileScope so the frame is only finished once that scope has added its time
+ */
+class ProfileFrameScope
+{
+public:
+    inline ProfileFrameScope() { Profiler::BeginFrame(); }
+    inline ~ProfileFrameScope() { Profiler::EndFrame(); }
+};
+
+/**
+ * Times a stage of startup between its creation and the end of the enclosing scope
+ * Also shows up as a zone in the trace when tracing
+ * Usage: StartupStage stage("LoadFonts");
+ */
+class StartupStage
+{
+private:
+    const char* name;
+    Uint64 start = 0;
+#ifdef WOLVERINE_TRACING
+    TraceZone trace_zone;
+#endif
+
+public:
+#ifdef WOLVERINE_TRACING
+    inline explicit StartupStage(const char* name) : name(name), start(SDL_GetPerformanceCounter()), trace_zone("startup", name) {}
+#else
+    inline explicit StartupStage(const char* name) : name(name), start(SDL_GetPerformanceCounter()) {}
+#endif
+
+    inline ~StartupStage()
+    {
+        Profiler::AddStartupStage(name, start, SDL_GetPerformanceCounter());
+    }
+};
+
+#endif /* Profiler_h */
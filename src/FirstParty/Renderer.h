@@ -40,6 +40,10 @@ private:
     
     // Determines wether debug elements will be drawn
     inline static bool draw_debug = false;
+    
+    // When headless there is no window or renderer, draw requests are only counted
+    inline static bool headless = false;
+    inline static long long headless_draw_count = 0;
 	
 	// queues for different kinds of render requests
 	inline static std::deque<ImageDrawRequest> image_draw_request_queue;
@@ -98,10 +102,29 @@ public:
 
 	/**
 	* Initializes the renderer
+	* Does nothing in headless mode, no window or renderer is ever created.
 	*
 	* @param	title	the title of the window to create
 	*/
 	static void Init(const std::string& title);
+    
+    /**
+    * Puts the renderer in headless mode. Must be called before Init.
+    * In headless mode draw requests are counted and then thrown away instead of being queued.
+    *
+    * @param    is_headless    true to run without a window or renderer
+    */
+    inline static void SetHeadless(const bool is_headless) { RendererData::headless = is_headless; } // SetHeadless()
+    
+    /**
+    * @returns    true if the engine is running without a window or renderer
+    */
+    inline static bool IsHeadless() { return RendererData::headless; } // IsHeadless()
+    
+    /**
+    * @returns    the number of draw requests that have been made while headless
+    */
+    inline static long long GetHeadlessDrawCount() { return RendererData::headless_draw_count; } // GetHeadlessDrawCount()
 
 	/**
 	* Loads in the renderer settings from the rendering config
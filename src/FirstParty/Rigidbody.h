@@ -20,6 +20,7 @@ class Rigidbody
 {
 public:
 	b2Body* body = nullptr;
+	BodyInterpolation interpolation; // Where the body was at the end of the previous simulation step
 
 	// Rigidbody parameters
 	float x = 0.0f;
@@ -62,6 +63,11 @@ public:
 	*/
 	void OnDestroy();
 
+	/**
+	* Destroys the rigidbody's body, called whenever the component is removed even if "OnDestroy" is skipped
+	*/
+	void Release();
+
 	// Setter functions
 
 	/**
@@ -136,6 +142,21 @@ public:
 	*/
 	float GetRotation();
 
+	/**
+	* Get the (x, y) position of the rigidbody blended between the last two simulation steps.
+	* Use this when drawing the rigidbody so that it moves smoothly regardless of the frame rate.
+	*
+	* @returns    a b2Vec2 containing the interpolated (x, y) position of the rb
+	*/
+	b2Vec2 GetInterpolatedPosition();
+
+	/**
+	* Get the rotation of the rigidbody blended between the last two simulation steps
+	*
+	* @returns    a float of the interpolated rotation of the rb in clockwise degrees
+	*/
+	float GetInterpolatedRotation();
+
 	/**
 	* Returns the current velocity of the rigidbody
 	*
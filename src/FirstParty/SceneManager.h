@@ -11,6 +11,18 @@
 
 #include "ActorManager.h"
 #include "SceneDB.h"
+#include "StringTable.h"
+
+/**
+ * Every actor in the scene that has the same name, in the order they were added to the scene
+ * Removing an actor leaves a -1 in its place, the list is packed again once half of it is -1s so the order is kept
+ */
+struct SceneNameBucket
+{
+    std::vector<int> actors;
+    int first_live = 0; // The index of the first entry that isn't -1
+    int num_removed = 0; // The number of -1 entries
+};
 
 class Scene
 {
@@ -18,8 +30,36 @@ private:
     static std::string current_scene_name; // The name of this scene
     static int current_scene_lifetime; // The number of frames this scene has been active for
     
-    static std::vector<int> actors; // A list of active actors indexes
+    static std::vector<int> actors; // The IDs of every actor in the scene, in no particular order
     static std::vector<int> dead_actors; // A list of actors that need to be deleted this frame
+    
+    // Indexed by actor slot (see Actors::GetSlot), where the actor is in "actors", -1 if it isn't in the scene
+    // Lets actors be removed from the scene without searching for them
+    inline static std::vector<int> actor_positions;
+    
+    inline static std::vector<SceneNameBucket> actors_by_name; // Indexed by the name ID of the actors (see StringTable)
+    inline static std::vector<int> name_positions; // Indexed by actor slot, where the actor is in its name bucket
+    
+    /**
+     * Packs a name bucket after enough of its actors have been removed
+     *
+     * @param   bucket    the bucket to pack
+    */
+    static void CompactNameBucket(SceneNameBucket& bucket);
+    
+    /**
+     * Adds an actor to the list of actors in the scene
+     *
+     * @param   actor_id    the id of the actor to add
+    */
+    static void AddActor(int actor_id);
+    
+    /**
+     * Removes an actor from the list of actors in the scene by moving the last actor into its place
+     *
+     * @param   actor_id    the id of the actor to remove, does nothing if it isn't in the scene
+    */
+    static void RemoveActor(int actor_id);
 public:
     static std::string new_scene_name; // The name of the new scene we're loading into
     static bool load_new_scene; // True if we want to load a new scene at the end of this frame
@@ -31,6 +71,11 @@ public:
     */
     static void UpdateActors();
     
+    /**
+     * Runs a single simulation step for all of the actors in this scene
+    */
+    static void FixedUpdateActors();
+    
     //-------------------------------------------------------
     // Loaders
     
@@ -47,6 +92,23 @@ public:
     */
     static void LoadNewScene();
     
+    /**
+     * Loads every actor in a scene document into the game and makes it the current scene
+     * LoadNewScene reads the document from resources/scenes, tools can build one in memory instead
+     *
+     * @param   scene_name      the name to give the loaded scene
+     * @param   scene_data      the scene document, structured the same as a .scene file
+    */
+    static void LoadSceneWithJSON(const std::string& scene_name, const rapidjson::Value& scene_data);
+    
+    /**
+     * Loads an actor from every blueprint into the game and makes it the current scene
+     *
+     * @param   scene_name      the name to give the loaded scene
+     * @param   blueprints      the blueprint of every actor in the scene
+    */
+    static void LoadSceneWithBlueprints(const std::string& scene_name, const std::vector<std::unique_ptr<ActorBlueprint>>& blueprints);
+    
     /**
      * Creates a new actor from a template and adds it to the current scene, then returns a reference to it
      *
@@ -55,6 +117,17 @@ public:
     */
     static int Instantiate(std::string actor_template_name);
     
+    /**
+     * Creates many actors from a template and adds them to the current scene
+     * Cheaper than calling Instantiate in a loop, the template is looked up once and storage for every actor is made at once
+     *
+     * @param   actor_template_name    the name of the template to make copies of in the scene
+     * @param   count                  the number of actors to create
+     * @param   init_fn                called as init_fn(actor_id, i) for each new actor before any of them start, to set per-instance values
+     * @returns                        a list of the ids of the newly created actors
+    */
+    static sol::table InstantiateMany(std::string actor_template_name, int count, sol::optional<sol::protected_function> init_fn);
+    
     /**
      * destroys an actor and then removes it from the scene
      *
@@ -62,6 +135,18 @@ public:
     */
     static void Destroy(Actor actor);
     
+    /**
+     * Destroys every actor in a list and removes them from the scene
+     *
+     * @param   actors_to_destroy    a Lua list of actors or actor IDs
+    */
+    static void DestroyMany(sol::table actors_to_destroy);
+    
+    /**
+     * Destroys every actor in the scene
+    */
+    static void DestroyAll();
+    
     //-------------------------------------------------------
     // Getters/Setters
     
@@ -74,12 +159,12 @@ public:
     
     /**
      * Finds an actor in the current scene that has the provided name
-     * If multiple actors have this name this returns the one that was loaded first
+     * If multiple actors have this name this returns the one that was added to the scene first
      *
      * @param   actor_name    the name of the actor that this function is trying to find
      * @returns               the found actor
     */
-    static Actor FindActorWithName(std::string actor_name);
+    static Actor FindActorWithName(std::string_view actor_name);
     
     /**
      * Finds all actors in the current scene that have the provided name
@@ -87,7 +172,32 @@ public:
      * @param   actor_name    the name of the actors that this function is trying to find
      * @returns               a list of indexes that represent actors with the given name
     */
-    static sol::table FindAllActorsWithName(std::string actor_name);
+    static sol::table FindAllActorsWithName(std::string_view actor_name);
+    
+    /**
+     * Gets the ID of a name, for scripts that search for the same name often
+     * The ID stays the same for the whole run, so it can be looked up once and kept
+     *
+     * @param   actor_name    the name to get the ID of
+     * @returns               the ID of the name
+    */
+    static int GetNameID(std::string_view actor_name);
+    
+    /**
+     * Same as FindActorWithName, but takes a name ID from GetNameID
+     *
+     * @param   name_id    the ID of the name of the actor that this function is trying to find
+     * @returns            the found actor
+    */
+    static Actor FindActorWithNameID(int name_id);
+    
+    /**
+     * Same as FindAllActorsWithName, but takes a name ID from GetNameID
+     *
+     * @param   name_id    the ID of the name of the actors that this function is trying to find
+     * @returns            a list of indexes that represent actors with the given name
+    */
+    static sol::table FindAllActorsWithNameID(int name_id);
     
     /**
      * Finds an actor with the given ID
@@ -0,0 +1,191 @@
+//
+//  ScriptProfiler.h
+//  wolverine_engine
+//
+//  Times every Lua lifecycle callback by component type and key so script hot spots can be found
+//
+
+#ifndef ScriptProfiler_h
+#define ScriptProfiler_h
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SDL.h"
+#include "sol/sol.hpp"
+#include "Tracer.h"
+
+/**
+ * Every component callback that the script profiler keeps track of
+ */
+enum SCRIPT_CALLBACK {
+    SCRIPT_CALLBACK_ON_START,
+    SCRIPT_CALLBACK_ON_UPDATE,
+    SCRIPT_CALLBACK_ON_LATE_UPDATE,
+    SCRIPT_CALLBACK_ON_FIXED_UPDATE,
+    SCRIPT_CALLBACK_ON_DESTROY,
+    SCRIPT_CALLBACK_ON_COLLISION_ENTER,
+    SCRIPT_CALLBACK_ON_COLLISION_EXIT,
+    SCRIPT_CALLBACK_ON_TRIGGER_ENTER,
+    SCRIPT_CALLBACK_ON_TRIGGER_EXIT,
+    SCRIPT_CALLBACK_ON_UPDATE_ALL,
+    SCRIPT_CALLBACK_ON_LATE_UPDATE_ALL,
+    SCRIPT_CALLBACK_ON_FIXED_UPDATE_ALL,
+    SCRIPT_CALLBACK_COUNT
+};
+
+/**
+ * The timings of one callback of one component (type + key)
+ * The IDs are only turned back into strings when the profile is reported
+ */
+struct ScriptProfileEntry
+{
+    int type_id = -1; // See StringTable
+    int key_id = -1; // See StringTable, -1 for the batched callbacks, which are called for every key of the type
+    SCRIPT_CALLBACK callback = SCRIPT_CALLBACK_ON_UPDATE;
+
+    // Since the profile was last reset
+    long long calls = 0;
+    double total_ms = 0.0;
+    float max_ms = 0.0f;
+    int worst_actor_name_id = -1; // See StringTable, the name of the actor that made the slowest call
+
+    // Since the last console report
+    long long window_calls = 0;
+    double window_ms = 0.0;
+};
+
+class ScriptProfiler
+{
+private:
+    inline static bool enabled = false; // Nothing is recorded unless this is true
+    inline static double counter_to_ms = 0.0; // Converts performance counter ticks to milliseconds
+
+    inline static std::vector<ScriptProfileEntry> entries; // Every type/key/callback that has been called
+    inline static std::unordered_map<unsigned long long, int> entry_indexes[SCRIPT_CALLBACK_COUNT]; // For each callback, the type and key IDs (see GetEntryKey) to the index in entries
+
+    inline static int report_interval_frames = 600; // How often the top entries are printed, 0 never prints
+    inline static int report_top_n = 10; // How many entries are printed in each report
+    inline static int frames_since_report = 0;
+
+    /**
+     * Packs a type ID and key ID into a single key for entry_indexes
+     *
+     * @param    type_id    the ID of the component's type
+     * @param    key_id     the ID of the component's key
+     * @returns             the key of the entry
+     */
+    static inline unsigned long long GetEntryKey(const int type_id, const int key_id)
+    {
+        return (static_cast<unsigned long long>(static_cast<unsigned int>(type_id)) << 32) | static_cast<unsigned int>(key_id);
+    }
+
+public:
+    /**
+     * Must be called before the first frame if script profiling is wanted
+     *
+     * @param    interval_frames    how many frames between each console report, 0 turns the report off
+     * @param    top_n              how many of the slowest callbacks are printed in each report
+     */
+    static void Init(const int interval_frames, const int top_n);
+
+    /**
+     * Adds a single call of a callback to the profile
+     *
+     * @param    type_id     the ID of the type of the component the callback was called on
+     * @param    key_id      the ID of the key of the component, -1 for batched callbacks
+     * @param    callback    which callback was called
+     * @param    actor_id    the id of the actor the component is on
+     * @param    start       the performance counter value when the call started
+     * @param    end         the performance counter value when the call ended
+     */
+    static void AddSample(const int type_id, const int key_id, const SCRIPT_CALLBACK callback, const int actor_id, const Uint64 start, const Uint64 end);
+
+    /**
+     * Call once at the end of every frame, prints the console report when it is due
+     */
+    static void EndFrame();
+
+    /**
+     * Prints the callbacks that took the most time since the last report, then starts a new report window
+     *
+     * @param    top_n    how many callbacks to print
+     */
+    static void PrintReport(const int top_n);
+
+    /**
+     * Throws away everything that has been recorded
+     */
+    static void Reset();
+
+    //-------------------------------------------------------
+    // Getters/Setters
+
+    /**
+     * @returns    true if the script profiler is recording
+     */
+    static inline bool IsEnabled() { return enabled; }
+
+    /**
+     * Gets the name of a callback
+     *
+     * @param    callback    the callback to get the name of
+     * @returns              the name of the lifecycle function
+     */
+    static const char* GetCallbackName(const SCRIPT_CALLBACK callback);
+
+    /**
+     * Gets the whole profile as a Lua table, sorted from most to least total time
+     * Each entry has type, key, callback, calls, total_ms, avg_ms, max_ms, and worst_actor
+     *
+     * @returns    a 1 indexed list of every profiled callback
+     */
+    static sol::table GetProfile();
+
+    /**
+     * Formats the actor name, component type, and key of a callback for the trace
+     *
+     * @param    type_id     the ID of the type of the component the callback was called on
+     * @param    key_id      the ID of the key of the component, -1 for batched callbacks
+     * @param    actor_id    the id of the actor the component is on
+     * @returns              the args of the callback's trace zone
+     */
+    static std::string GetTraceArgs(const int type_id, const int key_id, const int actor_id);
+};
+
+/**
+ * Times a single Lua callback between its creation and the end of the enclosing scope
+ * Also shows up as a zone in the trace when tracing
+ * Usage: ScriptProfileScope scope(state->type_id, state->key_id, SCRIPT_CALLBACK_ON_UPDATE, actor_id);
+ */
+class ScriptProfileScope
+{
+private:
+    int type_id;
+    int key_id;
+    SCRIPT_CALLBACK callback;
+    int actor_id;
+    Uint64 start = 0;
+#ifdef WOLVERINE_TRACING
+    TraceZone trace_zone;
+#endif
+
+public:
+#ifdef WOLVERINE_TRACING
+    inline ScriptProfileScope(const int type_id, const int key_id, const SCRIPT_CALLBACK callback, const int actor_id) : type_id(type_id), key_id(key_id), callback(callback), actor_id(actor_id), trace_zone("lua", ScriptProfiler::GetCallbackName(callback))
+#else
+    inline ScriptProfileScope(const int type_id, const int key_id, const SCRIPT_CALLBACK callback, const int actor_id) : type_id(type_id), key_id(key_id), callback(callback), actor_id(actor_id)
+#endif
+    {
+        if (ScriptProfiler::IsEnabled()) { start = SDL_GetPerformanceCounter(); }
+    }
+
+    inline ~ScriptProfileScope()
+    {
+        if (ScriptProfiler::IsEnabled()) { ScriptProfiler::AddSample(type_id, key_id, callback, actor_id, start, SDL_GetPerformanceCounter()); }
+        TRACE_ZONE_ARGS(trace_zone, ScriptProfiler::GetTraceArgs(type_id, key_id, actor_id));
+    }
+};
+
+#endif /* ScriptProfiler_h */
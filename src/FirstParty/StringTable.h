@@ -0,0 +1,53 @@
+//
+//  StringTable.h
+//  wolverine_engine
+//
+//  Interns strings that are compared often (actor names, component keys, etc.) so they can be compared and indexed by a small integer ID
+//
+
+#ifndef StringTable_h
+#define StringTable_h
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class StringTable
+{
+private:
+    // A deque never moves its elements, so the views in string_ids stay valid as strings are added
+    inline static std::deque<std::string> strings; // Indexed by string ID
+    inline static std::unordered_map<std::string_view, int> string_ids; // Points into "strings"
+
+public:
+    /**
+     * Gets the ID of a string, adding it to the table if it isn't there yet
+     * IDs are dense and never change, so they can be used to index vectors
+     *
+     * @param    text    the string to intern
+     * @returns          the ID of the string
+     */
+    static int Intern(std::string_view text);
+
+    /**
+     * Gets the ID of a string without adding it to the table
+     *
+     * @param    text    the string to look up
+     * @returns          the ID of the string, -1 if it has never been interned
+     */
+    static int Find(std::string_view text);
+
+    /**
+     * @param    string_id    the ID of an interned string
+     * @returns               the string with the given ID
+     */
+    static inline const std::string& GetString(int string_id) { return strings[string_id]; }
+
+    /**
+     * @returns    the number of interned strings, every ID is less than this
+     */
+    static inline int GetCount() { return static_cast<int>(strings.size()); }
+};
+
+#endif /* StringTable_h */
@@ -9,6 +9,9 @@
 #ifndef TemplateDB_h
 #define TemplateDB_h
 
+#include <string>
+#include <vector>
+
 #include "EngineUtils.h"
 
 /**
@@ -16,6 +19,16 @@
 */
 void LoadTemplates();
 
+/**
+ * Starts parsing all of the templates in the resources/actor_templates directory on the worker pool
+*/
+void StartLoadingTemplates();
+
+/**
+ * Waits for the templates started by StartLoadingTemplates and adds them to the database
+*/
+void FinishLoadingTemplates();
+
 /**
  * Get a template based on the templates name
  *
@@ -24,4 +37,9 @@ void LoadTemplates();
 */
 rapidjson::Document* GetTemplate(std::string template_name);
 
+/**
+ * @returns     the names of every loaded template
+*/
+std::vector<std::string> GetTemplateNames();
+
 #endif /* TemplateDB_h */
@@ -0,0 +1,118 @@
+//
+//  TimeManager.h
+//  wolverine_engine
+//
+//  Keeps track of the frame clock and drives the fixed simulation timestep.
+//
+
+#ifndef TimeManager_h
+#define TimeManager_h
+
+#include "SDL.h"
+
+class Time
+{
+private:
+    inline static Uint64 counter_frequency = 0; // The number of performance counter ticks per second
+    inline static Uint64 last_counter = 0; // The value of the performance counter at the start of the last frame
+
+    inline static float delta_time = 0.0f; // The scaled number of seconds the last frame took
+    inline static float unscaled_delta_time = 0.0f; // The number of seconds the last frame took, ignoring time_scale
+    inline static float time_scale = 1.0f; // How fast game time passes compared to real time
+    inline static double time = 0.0; // The scaled number of seconds since the game started
+
+    inline static float fixed_delta_time = 1.0f / 60.0f; // The length of a single simulation step in seconds
+    inline static float accumulator = 0.0f; // Game time that has passed but not been simulated yet
+    inline static int fixed_steps_this_frame = 0; // The number of simulation steps taken so far this frame
+    inline static int max_fixed_steps_per_frame = 5; // Stops a slow frame from snowballing into even slower frames
+
+    inline static float max_delta_time = 0.25f; // The longest a single frame is allowed to be (stops huge jumps after a hitch)
+    inline static float frame_delta_override = 0.0f; // If above 0 every frame is treated as taking exactly this long instead of measuring it
+
+public:
+    /**
+     * Must be called before the first frame, starts the frame clock
+     */
+    static void Init();
+
+    /**
+     * Call once at the start of every frame.
+     * Measures how long the previous frame took and adds it to the simulation accumulator.
+     */
+    static void BeginFrame();
+
+    /**
+     * Takes one fixed step worth of time out of the accumulator if there is enough of it.
+     * Call in a loop to run the simulation: while (Time::ConsumeFixedStep()) { ... }
+     *
+     * @returns    true if a fixed step should be simulated, false once the simulation has caught up
+     */
+    static bool ConsumeFixedStep();
+
+    /**
+     * How far between the last two simulation steps the current frame is.
+     * Used to interpolate the positions of physics bodies when rendering.
+     *
+     * @returns    [0, 1] 0 is the previous simulation step and 1 is the current one
+     */
+    static float GetInterpolationAlpha();
+
+    //-------------------------------------------------------
+    // Getters/Setters
+
+    /**
+     * @returns    the scaled number of seconds the last frame took
+     */
+    static float GetDeltaTime();
+
+    /**
+     * @returns    the number of seconds the last frame took, ignoring the time scale
+     */
+    static float GetUnscaledDeltaTime();
+
+    /**
+     * @returns    the length of a single simulation step in seconds
+     */
+    static float GetFixedDeltaTime();
+
+    /**
+     * Sets the length of a single simulation step
+     *
+     * @param    seconds    the new length of a simulation step in seconds
+     */
+    static void SetFixedDeltaTime(const float seconds);
+
+    /**
+     * @returns    how fast game time passes compared to real time
+     */
+    static float GetTimeScale();
+
+    /**
+     * Sets how fast game time passes compared to real time
+     *
+     * @param    scale    0 pauses the game, 1 is real time, 2 is double speed, etc.
+     */
+    static void SetTimeScale(const float scale);
+
+    /**
+     * @returns    the scaled number of seconds since the game started
+     */
+    static double GetTime();
+
+    /**
+     * Sets the maximum number of simulation steps that can be taken in a single frame
+     *
+     * @param    max_steps    the new maximum number of steps
+     */
+    static void SetMaxFixedStepsPerFrame(const int max_steps);
+    
+    /**
+     * Makes every frame advance game time by the same amount no matter how long it really took.
+     * Used by headless runs so the simulation stays deterministic while running uncapped.
+     *
+     * @param    seconds    the length of every frame, 0 goes back to measuring the frame clock
+     */
+    static void SetFrameDeltaOverride(const float seconds);
+};
+
+#endif /* TimeManager_h */
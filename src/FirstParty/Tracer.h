@@ -0,0 +1,138 @@
+//
+//  Tracer.h
+//  wolverine_engine
+//
+//  Writes a timeline of engine zones to a Chrome trace event file that can be opened in Perfetto or chrome://tracing
+//
+
+#ifndef Tracer_h
+#define Tracer_h
+
+#include <mutex>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "SDL.h"
+
+/**
+ * A single finished zone
+ */
+struct TraceEvent
+{
+    const char* name = ""; // Must point to a string that lives for the whole run
+    const char* category = ""; // Must point to a string that lives for the whole run
+    double start_us = 0.0; // Microseconds since tracing started
+    double duration_us = 0.0;
+    int thread_id = 0;
+    std::string args = ""; // Already formatted JSON object members, ex: "actor":"Player","type":"Rigidbody"
+};
+
+class Tracer
+{
+private:
+    inline static bool enabled = false; // Nothing is recorded unless this is true
+    inline static FILE* trace_file = nullptr;
+    inline static bool first_event = true; // True until the first event is written, events after it need a comma
+
+    inline static Uint64 start_counter = 0; // The performance counter value when tracing started
+    inline static double counter_to_us = 0.0; // Converts performance counter ticks to microseconds
+
+    inline static std::vector<TraceEvent> events; // Finished events that haven't been written yet
+    inline static std::mutex events_mutex; // Zones can finish on worker threads
+    inline static const size_t flush_threshold = 8192; // Events are written to the file in batches of this size
+
+    /**
+     * Writes every buffered event to the trace file
+     * events_mutex must be held by the caller
+     */
+    static void FlushEvents();
+
+public:
+    /**
+     * Starts recording zones and opens the trace file
+     *
+     * @param    path    where the trace is written
+     * @returns          true if the file could be opened
+     */
+    static bool Start(const std::string& path);
+
+    /**
+     * Writes everything that is left and closes the trace file, call before the game exits
+     */
+    static void Finish();
+
+    /**
+     * Adds a finished zone to the trace
+     *
+     * @param    category    what part of the engine the zone is in
+     * @param    name        the name of the zone
+     * @param    start       the performance counter value when the zone started
+     * @param    end         the performance counter value when the zone ended
+     * @param    args        formatted JSON object members shown with the zone, can be empty
+     */
+    static void AddEvent(const char* category, const char* name, const Uint64 start, const Uint64 end, std::string args);
+
+    /**
+     * Escapes a string so it can be put inside quotes in the trace file
+     *
+     * @param    text    the text to escape
+     * @returns          the escaped text
+     */
+    static std::string Escape(const std::string& text);
+
+    /**
+     * @returns    true if zones are being recorded
+     */
+    static inline bool IsEnabled() { return enabled; }
+
+    /**
+     * @returns    a small number that identifies the calling thread in the trace
+     */
+    static int GetThreadID();
+};
+
+/**
+ * Records a zone between its creation and the end of the enclosing scope
+ * Use the TRACE_ZONE macros instead of making these directly so tracing can be compiled out
+ */
+class TraceZone
+{
+private:
+    const char* category;
+    const char* name;
+    Uint64 start = 0;
+
+public:
+    std::string args = ""; // Can be filled in any time before the zone ends
+
+    inline TraceZone(const char* category, const char* name) : category(category), name(name)
+    {
+        if (Tracer::IsEnabled()) { start = SDL_GetPerformanceCounter(); }
+    }
+
+    inline ~TraceZone()
+    {
+        if (Tracer::IsEnabled() && start != 0) { Tracer::AddEvent(category, name, start, SDL_GetPerformanceCounter(), std::move(args)); }
+    }
+};
+
+// Zones are only compiled in when WOLVERINE_TRACING is defined (the WOLVERINE_TRACING CMake option)
+// When they are compiled in but --trace isn't used they cost a single branch
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef WOLVERINE_TRACING
+    // Traces the rest of the enclosing scope
+    #define TRACE_ZONE(category, name) TraceZone TRACE_CONCAT(trace_zone_, __LINE__)(category, name)
+    // Traces the rest of the enclosing scope, the zone can be given args later with TRACE_ZONE_ARGS
+    #define TRACE_ZONE_NAMED(variable, category, name) TraceZone variable(category, name)
+    // Sets the args of a named zone, the expression is only evaluated while tracing
+    #define TRACE_ZONE_ARGS(variable, args_expression) if (Tracer::IsEnabled()) { variable.args = (args_expression); }
+#else
+    #define TRACE_ZONE(category, name)
+    #define TRACE_ZONE_NAMED(variable, category, name)
+    #define TRACE_ZONE_ARGS(variable, args_expression)
+#endif
+
+#endif /* Tracer_h */
@@ -0,0 +1,86 @@
+//
+//  WorkerPool.h
+//  wolverine_engine
+//
+//  A small pool of worker threads for work that doesn't touch Lua or the renderer (decoding assets, parsing JSON, etc.)
+//
+
+#ifndef WorkerPool_h
+#define WorkerPool_h
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class WorkerPool
+{
+private:
+    inline static std::vector<std::thread> workers;
+    inline static std::queue<std::function<void()>> jobs; // Jobs that haven't been picked up by a worker yet
+    inline static std::mutex jobs_mutex;
+    inline static std::condition_variable jobs_available;
+    inline static bool stopping = false; // True once Shutdown has been called, workers exit when the queue is empty
+    inline static bool registered_exit_hook = false; // True once Shutdown has been registered with atexit
+
+    /**
+     * The loop every worker thread runs, takes jobs off the queue until the pool shuts down
+     */
+    static void WorkerLoop();
+
+public:
+    /**
+     * Starts the worker threads
+     * The workers are also joined if the engine exits early (ex: an error while loading), destroying running threads would terminate the process
+     *
+     * @param    num_threads    the number of workers to start, 0 uses one less than the number of cores
+     */
+    static void Init(int num_threads = 0);
+
+    /**
+     * Finishes every queued job and then stops the worker threads, does nothing if they aren't running
+     * Must be called from the main thread
+     */
+    static void Shutdown();
+
+    /**
+     * @returns    the number of worker threads, 0 if the pool isn't running
+     */
+    static inline int GetNumWorkers() { return static_cast<int>(workers.size()); }
+
+    /**
+     * Queues a job to run on a worker thread.
+     * If the pool isn't running the job runs right away on the calling thread.
+     * NOTE: Jobs must not touch the Lua state or the renderer, those only work on the main thread.
+     *
+     * @param    job    the function to run, its return value is handed back through the future
+     * @returns         a future that becomes ready when the job has finished
+     */
+    template<typename Job>
+    static auto Submit(Job&& job) -> std::future<decltype(job())>
+    {
+        using Result = decltype(job());
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Job>(job));
+        std::future<Result> result = task->get_future();
+
+        if (workers.empty())
+        {
+            (*task)();
+            return result;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex);
+            jobs.push([task]() { (*task)(); });
+        }
+        jobs_available.notify_one();
+
+        return result;
+    }
+};
+
+#endif /* WorkerPool_h */
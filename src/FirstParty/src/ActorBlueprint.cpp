@@ -0,0 +1,236 @@
+//
+//  ActorBlueprint.cpp
+//  wolverine_engine
+//
+//  Actor JSON compiled once into ready-made Lua values, so creating an actor doesn't have to walk or convert any JSON
+//
+
+#include <iostream>
+
+#include "ActorBlueprint.h"
+#include "ActorManager.h"
+#include "ComponentManager.h"
+#include "LuaAPI.h"
+#include "SceneDB.h"
+#include "StringTable.h"
+#include "TemplateDB.h"
+#include "Tracer.h"
+
+/**
+ * Gets the metatable shared by every component of a Lua component type
+ *
+ * @param   type_name    the name of the component type
+ * @returns              the metatable, its __index is the component type
+*/
+sol::table Blueprints::GetTypeMetatable(const std::string& type_name)
+{
+    auto found = type_metatables.find(type_name);
+    if (found != type_metatables.end()) { return found->second; }
+
+    sol::table metatable = LuaAPI::GetLuaState()->create_table();
+    metatable["__index"] = *GetComponentType(type_name);
+    type_metatables[type_name] = metatable;
+
+    return metatable;
+}
+
+/**
+ * Compiles a component from its JSON
+ *
+ * @param   key               the key of the component
+ * @param   component_data    the JSON of the component
+ * @param   actor_name        the name of the actor, for errors
+ * @returns                   the compiled component
+*/
+ComponentBlueprint Blueprints::CompileComponent(const std::string& key, const rapidjson::Value& component_data, const std::string& actor_name)
+{
+    sol::state& lua = *LuaAPI::GetLuaState();
+
+    // If the type for this component is not specified anywhere, throw an error
+    if (!component_data.HasMember("type"))
+    {
+        std::cout << "error: component type unspecified for " << key << " on " << actor_name;
+        exit(0);
+    }
+
+    ComponentBlueprint component;
+    component.type_name = component_data["type"].GetString();
+    component.type = sol::make_object(lua, component.type_name);
+    component.key = sol::make_object(lua, key);
+    component.type_id = StringTable::Intern(component.type_name);
+    component.key_id = StringTable::Intern(key);
+    component.native_type = ComponentManager::GetNativeComponentType(component.type_id);
+
+    // The properties are converted on a throwaway component, so each one gets the Lua type its default value has
+    sol::table prototype;
+    if (component.native_type != -1)
+    {
+        prototype = ComponentManager::NewNativeComponent(component.native_type);
+    }
+    else
+    {
+        component.metatable = GetTypeMetatable(component.type_name);
+        prototype = lua.create_table();
+        prototype[sol::metatable_key] = component.metatable;
+    }
+    prototype["type"] = component.type;
+    prototype["key"] = component.key;
+    prototype["enabled"] = true;
+
+    for (rapidjson::Value::ConstMemberIterator itr = component_data.MemberBegin(); itr != component_data.MemberEnd(); itr++)
+    {
+        std::string property_name = itr->name.GetString();
+        if (property_name == "type") { continue; } // Already set on every instance
+
+        sol::type property_type = prototype[property_name].get_type();
+
+        sol::lua_value property = "";
+        Actors::JsonToLuaObject(property, itr->value, property_type);
+        prototype[property_name] = property;
+
+        // Read back from the prototype, native components store the value as their member's type
+        sol::object value = prototype[property_name];
+        component.properties.emplace_back(sol::make_object(lua, property_name), value);
+    }
+
+    return component;
+}
+
+/**
+ * Compiles the JSON of an actor into a blueprint
+ *
+ * @param   actor_data    the JSON of the actor, structured the same as a template
+ * @returns               the compiled blueprint
+*/
+std::unique_ptr<ActorBlueprint> Blueprints::Compile(const rapidjson::Value& actor_data)
+{
+    std::unique_ptr<ActorBlueprint> blueprint = std::make_unique<ActorBlueprint>();
+
+    // Gives this actor a default name if none is specified for it
+    blueprint->name_id = StringTable::Intern(actor_data.HasMember("name") ? actor_data["name"].GetString() : "ActorName");
+    if (actor_data.HasMember("enabled")) { blueprint->enabled = actor_data["enabled"].GetBool(); }
+
+    // Templates opt in to pooling with "pooled": true, or by asking for a prewarmed pool
+    if (actor_data.HasMember("prewarm"))
+    {
+        blueprint->prewarm = actor_data["prewarm"].GetInt();
+        blueprint->pooled = true;
+    }
+    if (actor_data.HasMember("pooled")) { blueprint->pooled = actor_data["pooled"].GetBool(); }
+
+    if (actor_data.HasMember("components"))
+    {
+        const rapidjson::Value& actor_components = actor_data["components"];
+        for (rapidjson::Value::ConstMemberIterator itr = actor_components.MemberBegin(); itr != actor_components.MemberEnd(); itr++)
+        {
+            blueprint->components.push_back(CompileComponent(itr->name.GetString(), itr->value, StringTable::GetString(blueprint->name_id)));
+        }
+    }
+
+    return blueprint;
+}
+
+/**
+ * Compiles every actor in a scene document, combining actors with their templates first
+ *
+ * @param   scene_data    the scene document, structured the same as a .scene file
+ * @returns               the blueprint of every actor in the scene, in order
+*/
+std::vector<std::unique_ptr<ActorBlueprint>> Blueprints::CompileScene(const rapidjson::Value& scene_data)
+{
+    TRACE_ZONE("assets", "Blueprints::CompileScene");
+
+    std::vector<std::unique_ptr<ActorBlueprint>> blueprints;
+    if (!scene_data.HasMember("actors")) { return blueprints; }
+
+    for (auto& member : scene_data["actors"].GetArray())
+    {
+        // If the actor has a value for template, combine the actor with the template before compiling it
+        if (member.HasMember("template"))
+        {
+            rapidjson::Document combined_actor;
+
+            rapidjson::Document lhs;
+            lhs.CopyFrom(member, lhs.GetAllocator());
+            rapidjson::Document rhs;
+            rhs.CopyFrom(*GetTemplate(member["template"].GetString()), rhs.GetAllocator());
+
+            EngineUtils::CombineJsonDocuments(lhs, rhs, combined_actor);
+
+            blueprints.push_back(Compile(combined_actor));
+        }
+        else
+        {
+            blueprints.push_back(Compile(member));
+        }
+    }
+
+    return blueprints;
+}
+
+/**
+ * Compiles every loaded template, called once at startup after the component types and templates are loaded
+*/
+void Blueprints::CompileTemplates()
+{
+    for (const std::string& template_name : GetTemplateNames())
+    {
+        GetTemplateBlueprint(template_name);
+    }
+}
+
+/**
+ * Gets the blueprint of a template, compiling it if it hasn't been yet
+ *
+ * @param   template_name    the name of the template
+ * @returns                  the blueprint of the template
+*/
+ActorBlueprint& Blueprints::GetTemplateBlueprint(const std::string& template_name)
+{
+    auto found = template_blueprints.find(template_name);
+    if (found != template_blueprints.end()) { return *found->second; }
+
+    std::unique_ptr<ActorBlueprint>& blueprint = template_blueprints[template_name];
+    blueprint = Compile(*GetTemplate(template_name));
+    return *blueprint;
+}
+
+/**
+ * Gets the blueprints of every actor in a scene in resources/scenes, the scene file is only read and compiled the first time
+ *
+ * @param   scene_name    the name of the scene
+ * @returns               the blueprint of every actor in the scene, in order
+*/
+const std::vector<std::unique_ptr<ActorBlueprint>>& Blueprints::GetSceneBlueprints(const std::string& scene_name)
+{
+    auto found = scene_blueprints.find(scene_name);
+    if (found != scene_blueprints.end()) { return found->second; }
+
+    rapidjson::Document scene_document;
+    EngineUtils::ReadJsonFile(GetScenePath(scene_name), scene_document);
+
+    std::vector<std::unique_ptr<ActorBlueprint>>& blueprints = scene_blueprints[scene_name];
+    blueprints = CompileScene(scene_document);
+    return blueprints;
+}
+
+/**
+ * Gets a property value for a new component
+ * Tables are copied so components never share one, every other value is returned as is
+ *
+ * @param   value    a property value from a blueprint
+ * @returns          the value to give the component
+*/
+sol::object Blueprints::CopyValue(const sol::object& value)
+{
+    if (value.get_type() != sol::type::table) { return value; }
+
+    sol::table source = value.as<sol::table>();
+    sol::table copy = LuaAPI::GetLuaState()->create_table();
+    for (const auto& [entry_key, entry_value] : source)
+    {
+        copy.raw_set(entry_key, CopyValue(entry_value));
+    }
+
+    return copy;
+}
@@ -6,207 +6,335 @@
 //  Manages actors
 //
 
+#include <algorithm>
 #include <stdio.h>
 
 #include "ActorManager.h"
+#include "Coroutines.h"
 #include "LuaAPI.h"
+#include "Profiler.h"
+#include "ScriptProfiler.h"
 
 int Actors::num_total_actors = 0; // The total number of actors created during runtime
 int Actors::num_loaded_actors = 0; // The number of actors currently loaded in the game
 
-std::unordered_map<int, int> Actors::id_to_index; // map of an actors id to its current index in the vectors
-
 // The attributes of all the loaded actors
-std::vector<std::string> Actors::names;
+std::vector<int> Actors::name_ids;
 std::vector<int> Actors::IDs;
 std::vector<bool> Actors::actor_enabled;
 
 //-------------------------------------------------------
 // Lifecycle Functions
 
-/**
- * Cleans all of the dead actors out from the vectors
-*/
-void Actors::Cleanup()
-{
-    // Erase the dead actors from every vector
-    int i = 0;
-    while (i < num_loaded_actors)
-    {
-        if (IDs[i] == -1)
-        {
-            // Erase from the vectors
-            IDs.erase(IDs.begin() + i);
-            names.erase(names.begin() + i);
-            actor_enabled.erase(actor_enabled.begin() + i);
-            components.erase(components.begin() + i);
-        }
-        else
-        {
-            i++;
-        }
-    }
-    
-    // Update the id_to_index map with new indexes for living ids
-    for (int i = 0; i < IDs.size(); i++) 
-    {
-        id_to_index[IDs[i]] = i;
-    }
-}
-
 /**
  * Processes all components added to all actors on the previous frame
 */
 void Actors::ProcessAddedComponents()
 {
-    // Stores the components that didn't get processed this frame, so we can re-add
-    // them to "components_to_init" when we've finished processing the others
-    std::vector<std::shared_ptr<sol::table>> not_processed;
+    ProfileScope scope(PROFILER_PHASE_ADDED_COMPONENTS);
     
-    for (auto& component : components_to_init)
+    // Taken out of "components_to_init" first, "OnStart" can instantiate actors which adds to it
+    // Those are processed next frame
+    components_starting.swap(components_to_init);
+    
+    for (auto& state : components_starting)
     {
-        int actor_index = GetIndex((*component)["actor"]["ID"]);
+        state->waiting_to_start = false;
         
         // If this component has been removed, skip it
-        if ((*component)["REMOVED_FROM_ACTOR"] == true)
-        {
-            continue;
-        }
+        if (state->removed) { continue; }
         
         // Skip this component if the actor or component aren't enabled
-        if (!actor_enabled[actor_index] || (*component)["enabled"] == false)
+        // It is queued again once it is enabled (see UpdateActivation)
+        int actor_index = GetIndex(state->actor_id);
+        if (!state->enabled || !actor_enabled[actor_index]) { continue; }
+        
+        // Native components are started directly, and go in the native update lists (see UpdateActivation)
+        if (state->native_type != -1)
         {
-            not_processed.push_back(component);
+            state->started = true;
+            UpdateActivation(state);
+            
+            const NativeComponentType& native_type = ComponentManager::GetNativeType(state->native_type);
+            if (native_type.on_start)
+            {
+                ScriptProfileScope profile_scope(state->type_id, state->key_id, SCRIPT_CALLBACK_ON_START, IDs[actor_index]);
+                native_type.on_start(state->native);
+            }
             continue;
         }
         
-        // Add to the appropriate lifecycle functions list so that they will start being called by the engine.
-        sol::function OnUpdate = (*component)["OnUpdate"];
-        if (OnUpdate.valid()) { components_to_update.push_back(component); }
-        sol::function OnLateUpdate = (*component)["OnLateUpdate"];
-        if (OnLateUpdate.valid()) { components_to_update_late.push_back(component); }
+        sol::table& component = *state->component;
+        
+        // Find the per-frame lifecycle functions once, the component is added to the lists of the ones it has when it is active
+        state->on_update = component["OnUpdate"];
+        state->on_late_update = component["OnLateUpdate"];
+        state->on_fixed_update = component["OnFixedUpdate"];
+        state->batch = GetTypeBatch(component, state->type_id);
+        if (state->on_update.valid()) { state->update_bucket = GetUpdateBucket(component); }
+        
+        state->started = true;
+        UpdateActivation(state);
         
         // Call "OnStart" if it exists for this component
         try
         {
             // OnStart is called for each component the frame they are loaded into the game
-            sol::function OnStart = (*component)["OnStart"];
+            sol::function OnStart = component["OnStart"];
             if (OnStart.valid())
             {
-                OnStart(*component);
+                ScriptProfileScope profile_scope(state->type_id, state->key_id, SCRIPT_CALLBACK_ON_START, IDs[actor_index]);
+                running_component = state.get();
+                OnStart(component);
+                running_component = nullptr;
             }
         }
         catch(const std::exception& e)
         {
+            running_component = nullptr;
             std::string errorMessage = e.what();
 #ifdef _WIN32
             std::replace(errorMessage.begin(), errorMessage.end(), '\\', '/');
 #endif
-            std::cout << "\033[31m" << names[actor_index] << " : " << errorMessage << "\033[0m" << std::endl;
+            std::cout << "\033[31m" << StringTable::GetString(name_ids[actor_index]) << " : " << errorMessage << "\033[0m" << std::endl;
         }
     }
     
-    // Remove all the processed components from the list
-    components_to_init.clear();
-    components_to_init = not_processed;
+    components_starting.clear();
 }
 
 /**
- * Calls "OnUpdate" for every component that has it
+ * Calls "OnUpdate" for every component that has it, in the order and at the rate its schedule sets
 */
 void Actors::Update()
 {
-    std::vector<std::shared_ptr<sol::table>> living_components; // The "Update" list without any of the dead components
+    ProfileScope scope(PROFILER_PHASE_UPDATE);
     
-    for (auto& component : components_to_update)
+    update_frame++;
+    for (int bucket_index : update_order)
     {
-        // If this component is dead, skip it
-        if ((*component)["REMOVED_FROM_ACTOR"] == true)
+        UpdateBucket& bucket = update_buckets[bucket_index];
+        if (std::find(disabled_update_groups.begin(), disabled_update_groups.end(), bucket.group_id) != disabled_update_groups.end()) { continue; }
+        
+        if (bucket.sliced)
         {
-            continue;
+            // Runs every frame, with only the entries whose turn it is called
+            RunUpdateList(bucket.components, &ComponentState::on_update, SCRIPT_CALLBACK_ON_UPDATE, update_frame % bucket.interval);
         }
-        
-        int actor_index = GetIndex((*component)["actor"]["ID"]);
-        
-        // The component is alive! add it to living components
-        living_components.push_back(component);
-    
-        // Skip this component if the actor or component aren't enabled
-        if (!actor_enabled[actor_index] || (*component)["enabled"] == false)
+        else if (update_frame % bucket.interval == 0)
         {
-            continue;
+            RunUpdateList(bucket.components, &ComponentState::on_update, SCRIPT_CALLBACK_ON_UPDATE);
         }
+    }
+    
+    RunTypeBatches(&ComponentTypeBatch::to_update, &ComponentTypeBatch::on_update_all, SCRIPT_CALLBACK_ON_UPDATE_ALL);
+    
+    // Native components update after the scripts, so sprites and particles use this frame's values
+    for (int native_type = 0; native_type < static_cast<int>(native_components_to_update.size()); native_type++)
+    {
+        RunNativeUpdateList(native_components_to_update[native_type], ComponentManager::GetNativeType(native_type).on_update);
+    }
+}
+
+/**
+ * Calls "OnLateUpdate" for every component that has it
+*/
+void Actors::LateUpdate()
+{
+    ProfileScope scope(PROFILER_PHASE_LATE_UPDATE);
+    RunUpdateList(components_to_update_late, &ComponentState::on_late_update, SCRIPT_CALLBACK_ON_LATE_UPDATE);
+    RunTypeBatches(&ComponentTypeBatch::to_update_late, &ComponentTypeBatch::on_late_update_all, SCRIPT_CALLBACK_ON_LATE_UPDATE_ALL);
+}
+
+/**
+ * Calls "OnFixedUpdate" for every component that has it
+ * Called once per simulation step, which can be zero or several times in a single frame
+*/
+void Actors::FixedUpdate()
+{
+    RunUpdateList(components_to_update_fixed, &ComponentState::on_fixed_update, SCRIPT_CALLBACK_ON_FIXED_UPDATE);
+    RunTypeBatches(&ComponentTypeBatch::to_update_fixed, &ComponentTypeBatch::on_fixed_update_all, SCRIPT_CALLBACK_ON_FIXED_UPDATE_ALL);
+}
+
+/**
+ * Calls one lifecycle function on every live component in an update list, dropping entries that are no longer live
+ *
+ * @param   list        the update list
+ * @param   function    the lifecycle function of each component to call
+ * @param   callback    the callback to report to the script profiler
+ * @param   phase       if not -1, only entries with this phase are called, the rest are only kept
+*/
+void Actors::RunUpdateList(std::vector<ComponentRef>& list, sol::protected_function ComponentState::* function, SCRIPT_CALLBACK callback, int phase)
+{
+    // Components enabled during this loop are added to the end of the list, they are run starting next time
+    // Indexed instead of iterated since adding to the list can move it
+    const size_t num_components = list.size();
+    size_t num_living = 0; // Living entries are moved down over the dead ones, keeping the update order
+    for (size_t i = 0; i < num_components; i++)
+    {
+        // If this component was disabled or removed since this entry was made, drop it
+        ComponentState* state = list[i].state.get();
+        if (list[i].activation != state->activation) { continue; }
         
-        // Call "OnUpdate"
-        try
+        // The component is alive! keep it
+        if (num_living != i) { list[num_living] = std::move(list[i]); }
+        num_living++;
+        
+        // Time sliced components only run on their turn
+        if (phase != -1 && list[num_living - 1].phase != phase) { continue; }
+        
+        // Call the lifecycle function, only components that have it are put in the list
+        sol::table& component = *state->component;
+        sol::protected_function_result result;
         {
-            sol::function OnUpdate = (*component)["OnUpdate"];
-            if (OnUpdate.valid())
-            {
-                OnUpdate(*component);
-            }
+            ScriptProfileScope profile_scope(state->type_id, state->key_id, callback, state->actor_id);
+            running_component = state;
+            result = (state->*function)(component);
+            running_component = nullptr;
         }
-        catch(const std::exception& e)
+        
+        if (!result.valid())
         {
-            std::string errorMessage = e.what();
+            sol::error error = result;
+            std::string errorMessage = error.what();
 #ifdef _WIN32
             std::replace(errorMessage.begin(), errorMessage.end(), '\\', '/');
 #endif
-            std::cout << "\033[31m" << names[actor_index] << " : " << errorMessage << "\033[0m" << std::endl;
+            std::cout << "\033[31m" << GetName(state->actor_id) << " : " << errorMessage << "\033[0m" << std::endl;
         }
     }
     
-    components_to_update.clear();
-    components_to_update = living_components;
+    // Nothing was dropped, so nothing has to move
+    if (num_living == num_components) { return; }
+    
+    std::move(list.begin() + num_components, list.end(), list.begin() + num_living);
+    list.resize(list.size() - (num_components - num_living));
 }
 
 /**
- * Calls "OnLateUpdate" for every component that has it
+ * Gets the bucket a component's "OnUpdate" is scheduled in, making it if no other component has used the same schedule yet
+ * The schedule is read from the component, so it can be set on the component type or on each component in a template or scene
+ *
+ * @param   component    the component
+ * @returns              the index of the bucket in "update_buckets"
 */
-void Actors::LateUpdate()
+int Actors::GetUpdateBucket(const sol::table& component)
+{
+    int group_id = StringTable::Intern(component.get_or<std::string>("update_group", "default"));
+    int priority = component.get_or("update_priority", 0);
+    int interval = std::max(component.get_or("update_interval", 1), 1);
+    bool sliced = interval > 1 && component.get_or("update_sliced", false);
+    
+    for (int i = 0; i < static_cast<int>(update_buckets.size()); i++)
+    {
+        const UpdateBucket& bucket = update_buckets[i];
+        if (bucket.group_id == group_id && bucket.priority == priority && bucket.interval == interval && bucket.sliced == sliced) { return i; }
+    }
+    
+    UpdateBucket bucket;
+    bucket.group_id = group_id;
+    bucket.priority = priority;
+    bucket.interval = interval;
+    bucket.sliced = sliced;
+    
+    int bucket_index = static_cast<int>(update_buckets.size());
+    update_buckets.push_back(std::move(bucket));
+    
+    // After every bucket with the same priority, so buckets with equal priority run in the order they were made
+    auto position = std::upper_bound(update_order.begin(), update_order.end(), priority, [](int priority, int other_index) { return priority < update_buckets[other_index].priority; });
+    update_order.insert(position, bucket_index);
+    
+    return bucket_index;
+}
+
+/**
+ * Gets the batched functions of a component's type, looking them up the first time a component of the type starts
+ *
+ * @param   component    a component of the type
+ * @param   type_id      the ID of the type
+ * @returns              the index of the type in "type_batches", -1 if the type has no batched functions
+*/
+int Actors::GetTypeBatch(const sol::table& component, int type_id)
 {
-    std::vector<std::shared_ptr<sol::table>> living_components; // The "LateUpdate" list without any of the dead components
+    if (type_id == -1) { return -1; }
+    if (type_id >= static_cast<int>(type_batch_ids.size())) { type_batch_ids.resize(StringTable::GetCount(), -2); }
+    if (type_batch_ids[type_id] != -2) { return type_batch_ids[type_id]; }
+    
+    // Lua components read these from their type through the metatable, native components don't have them
+    ComponentTypeBatch batch;
+    batch.on_update_all = component["OnUpdateAll"];
+    batch.on_late_update_all = component["OnLateUpdateAll"];
+    batch.on_fixed_update_all = component["OnFixedUpdateAll"];
+    
+    if (!batch.on_update_all.valid() && !batch.on_late_update_all.valid() && !batch.on_fixed_update_all.valid())
+    {
+        type_batch_ids[type_id] = -1;
+        return -1;
+    }
+    
+    sol::state& lua = *LuaAPI::GetLuaState();
+    batch.instances = lua.create_table();
+    batch.type_id = type_id;
     
-    for (auto& component : components_to_update_late)
+    type_batch_ids[type_id] = static_cast<int>(type_batches.size());
+    type_batches.push_back(std::move(batch));
+    return type_batch_ids[type_id];
+}
+
+/**
+ * Calls one batched function of every component type that has it, with the type's live components
+ *
+ * @param   list        the list of each type to run
+ * @param   function    the batched function of each type to call
+ * @param   callback    the callback to report to the script profiler
+*/
+void Actors::RunTypeBatches(std::vector<ComponentRef> ComponentTypeBatch::* list, sol::protected_function ComponentTypeBatch::* function, SCRIPT_CALLBACK callback)
+{
+    for (ComponentTypeBatch& batch : type_batches)
     {
-        // If this component is dead, skip it
-        if ((*component)["REMOVED_FROM_ACTOR"] == true)
+        std::vector<ComponentRef>& components = batch.*list;
+        if (!(batch.*function).valid()) { continue; }
+        
+        // Drop the dead entries in place, the same as RunUpdateList, while filling the instances array with the live ones
+        // Nothing is called until the array is filled, so the list can't change during this loop
+        int num_living = 0;
+        for (int i = 0; i < static_cast<int>(components.size()); i++)
         {
-            continue;
+            ComponentState* state = components[i].state.get();
+            if (components[i].activation != state->activation) { continue; }
+            
+            if (num_living != i) { components[num_living] = std::move(components[i]); }
+            num_living++;
+            batch.instances.raw_set(num_living, *state->component);
         }
+        components.resize(num_living);
         
-        int actor_index = GetIndex((*component)["actor"]["ID"]);
-        
-        // The component is alive! add it to living components
-        living_components.push_back(component);
-        
-        // Skip this component if the actor or component aren't enabled
-        if (!actor_enabled[actor_index] || (*component)["enabled"] == false)
+        // Clear out the rest of the array from last time, so its length is the number of live components
+        for (int i = num_living + 1; i <= batch.num_instances; i++)
         {
-            continue;
+            batch.instances.raw_set(i, sol::lua_nil);
         }
+        batch.num_instances = num_living;
         
-        // Call "OnLateUpdate"
-        try
+        if (num_living == 0) { continue; }
+        
+        // Components enabled by the batched function are added to the end of the list, they are in the array starting next time
+        sol::protected_function_result result;
         {
-            sol::function OnLateUpdate = (*component)["OnLateUpdate"];
-            if (OnLateUpdate.valid())
-            {
-                OnLateUpdate(*component);
-            }
+            ScriptProfileScope profile_scope(batch.type_id, -1, callback, -1);
+            result = (batch.*function)(batch.instances);
         }
-        catch(const std::exception& e)
+        
+        if (!result.valid())
         {
-            std::string errorMessage = e.what();
+            sol::error error = result;
+            std::string errorMessage = error.what();
 #ifdef _WIN32
             std::replace(errorMessage.begin(), errorMessage.end(), '\\', '/');
 #endif
-            std::cout << "\033[31m" << names[actor_index] << " : " << errorMessage << "\033[0m" << std::endl;
+            std::cout << "\033[31m" << StringTable::GetString(batch.type_id) << " : " << errorMessage << "\033[0m" << std::endl;
         }
     }
-    
-    components_to_update_late.clear();
-    components_to_update_late = living_components;
 }
 
 /**
@@ -214,17 +342,44 @@ void Actors::LateUpdate()
 */
 void Actors::ProcessRemovedComponents()
 {
-    while (components_to_delete.size() > 0)
+    ProfileScope scope(PROFILER_PHASE_REMOVED_COMPONENTS);
+    
+    // Indexed instead of iterated since "OnDestroy" can destroy more actors, which adds to the list
+    for (size_t i = 0; i < components_to_delete.size(); i++)
     {
-        auto& component = components_to_delete.front();
+        std::shared_ptr<ComponentState> state = std::move(components_to_delete[i].first);
+        bool pooled = components_to_delete[i].second;
+        auto& component = state->component;
         
-        int actor_index = GetIndex((*component)["actor"]["ID"]);
-        bool enabled_actor = actor_enabled[actor_index];
-        bool enabled_component = (*component)["enabled"];
+        int actor_index = GetIndex(state->actor_id);
+        bool enabled_actor = actor_index != -1 && actor_enabled[actor_index];
+        
+        // Its coroutines are thrown away now instead of whenever they would have come due, which could be never
+        // Coroutines started by "OnDestroy" are thrown away the first time they yield, since the component is already removed
+        Coroutines::StopComponentCoroutines(*state);
         
         // Skip caling "OnDestroy" on this component if the actor or component aren't enabled
-        if (!enabled_actor || !enabled_component)
+        // It still has to be deleted, and native components still have to let go of engine resources that point at them
+        if (!enabled_actor || !state->enabled)
+        {
+            if (state->native_type != -1)
+            {
+                const NativeComponentType& native_type = ComponentManager::GetNativeType(state->native_type);
+                if (native_type.release) { native_type.release(state->native); }
+            }
+            if (!pooled) { LuaAPI::DeleteLuaTable(component); }
+            continue;
+        }
+        
+        if (state->native_type != -1)
         {
+            const NativeComponentType& native_type = ComponentManager::GetNativeType(state->native_type);
+            if (native_type.on_destroy)
+            {
+                ScriptProfileScope profile_scope(state->type_id, state->key_id, SCRIPT_CALLBACK_ON_DESTROY, IDs[actor_index]);
+                native_type.on_destroy(state->native);
+            }
+            if (!pooled) { LuaAPI::DeleteLuaTable(component); }
             continue;
         }
         
@@ -234,22 +389,108 @@ void Actors::ProcessRemovedComponents()
             sol::function OnDestroy = (*component)["OnDestroy"];
             if (OnDestroy.valid())
             {
+                ScriptProfileScope profile_scope(state->type_id, state->key_id, SCRIPT_CALLBACK_ON_DESTROY, IDs[actor_index]);
+                running_component = state.get();
                 OnDestroy(*component);
+                running_component = nullptr;
             }
         }
         catch(const std::exception& e)
         {
+            running_component = nullptr;
             std::string errorMessage = e.what();
 #ifdef _WIN32
             std::replace(errorMessage.begin(), errorMessage.end(), '\\', '/');
 #endif
-            std::cout << "\033[31m" << names[actor_index] << " : " << errorMessage << "\033[0m" << std::endl;
+            std::cout << "\033[31m" << StringTable::GetString(name_ids[actor_index]) << " : " << errorMessage << "\033[0m" << std::endl;
         }
         
-        // Deletes the component
-        LuaAPI::DeleteLuaTable(component);
-        components_to_delete.pop();
+        // Deletes the component, pooled components are kept as they are until they are reused
+        if (!pooled) { LuaAPI::DeleteLuaTable(component); }
+    }
+    
+    components_to_delete.clear();
+}
+
+/**
+ * Makes the record of a new component and queues it to start if it and its actor are enabled
+ *
+ * @param   component    the component
+ * @param   actor_id     the id of the actor the component is on, it must be the last actor in the vectors
+ * @param   type_id      the ID of the component's type
+ * @param   key_id       the ID of the component's key
+*/
+void Actors::AddComponentState(const std::shared_ptr<sol::table>& component, int actor_id, int type_id, int key_id)
+{
+    std::shared_ptr<ComponentState> state = std::make_shared<ComponentState>();
+    state->component = component;
+    state->actor_id = actor_id;
+    state->type_id = type_id;
+    state->key_id = key_id;
+    state->native_type = ComponentManager::GetNativeComponentType(type_id);
+    if (state->native_type != -1) { state->native = ComponentManager::GetNativeType(state->native_type).get(*component); }
+    
+    // The blueprint can set "enabled", this is the only time the engine reads it from the component
+    state->enabled = (*component)["enabled"].get_or(true);
+    
+    component_states.back().push_back(state);
+    UpdateActivation(state);
+}
+
+/**
+ * Moves a component in or out of the lifecycle lists to match whether it and its actor are enabled
+ *
+ * @param   state    the record of the component
+*/
+void Actors::UpdateActivation(const std::shared_ptr<ComponentState>& state)
+{
+    int actor_index = GetIndex(state->actor_id);
+    bool should_run = !state->removed && state->enabled && actor_index != -1 && actor_enabled[actor_index];
+    
+    // Components that haven't started yet start once they are enabled
+    if (!state->started)
+    {
+        if (should_run && !state->waiting_to_start)
+        {
+            state->waiting_to_start = true;
+            components_to_init.push_back(state);
+        }
+        return;
+    }
+    
+    if (should_run == state->active) { return; }
+    
+    // Either way every existing entry stops matching, so a component that is disabled and enabled again in one frame is only in each list once
+    state->activation++;
+    state->active = should_run;
+    if (!should_run) { return; }
+    
+    if (state->native_type != -1)
+    {
+        if (ComponentManager::GetNativeType(state->native_type).on_update)
+        {
+            if (state->native_type >= static_cast<int>(native_components_to_update.size())) { native_components_to_update.resize(ComponentManager::GetNativeTypeCount()); }
+            native_components_to_update[state->native_type].push_back({state, state->activation});
+        }
+        return;
+    }
+    
+    // Types with a batched function have it called instead of the function of each component
+    ComponentTypeBatch* batch = state->batch == -1 ? nullptr : &type_batches[state->batch];
+    
+    if (batch && batch->on_update_all.valid()) { batch->to_update.push_back({state, state->activation}); }
+    else if (state->on_update.valid())
+    {
+        UpdateBucket& bucket = update_buckets[state->update_bucket];
+        bucket.components.push_back({state, state->activation, bucket.next_phase});
+        if (bucket.sliced) { bucket.next_phase = (bucket.next_phase + 1) % bucket.interval; }
     }
+    
+    if (batch && batch->on_late_update_all.valid()) { batch->to_update_late.push_back({state, state->activation}); }
+    else if (state->on_late_update.valid()) { components_to_update_late.push_back({state, state->activation}); }
+    
+    if (batch && batch->on_fixed_update_all.valid()) { batch->to_update_fixed.push_back({state, state->activation}); }
+    else if (state->on_fixed_update.valid()) { components_to_update_fixed.push_back({state, state->activation}); }
 }
 
 //-------------------------------------------------------
@@ -261,12 +502,28 @@ void Actors::ProcessRemovedComponents()
  * @param   actor_id    the id of the actor that this function is acting on
  * @returns             the name of the given actor
 */
-std::string Actors::GetName(int actor_id)
+const std::string& Actors::GetName(int actor_id)
+{
+    static const std::string no_name = "";
+    
+    int actor_index = GetIndex(actor_id);
+    if (actor_index == -1) {return no_name;}
+    
+    return StringTable::GetString(name_ids[actor_index]);
+}
+
+/**
+ * Returns the ID of this actors name in the StringTable
+ *
+ * @param   actor_id    the id of the actor that this function is acting on
+ * @returns             the name ID of the given actor, -1 if the actor doesn't exist
+*/
+int Actors::GetNameID(int actor_id)
 {
     int actor_index = GetIndex(actor_id);
-    if (actor_index == -1) {return "";}
+    if (actor_index == -1) {return -1;}
     
-    return names[actor_index];
+    return name_ids[actor_index];
 }
 
 /**
@@ -296,114 +553,306 @@ int Actors::GetID(int actor_id)
 */
 int Actors::LoadActorWithJSON(const rapidjson::Value& actor_data)
 {
-    // Gives actor their ID
-    IDs.push_back(num_total_actors);
-    int index = (int)IDs.size() - 1;
-    id_to_index[num_total_actors] = index;
+    return LoadActorWithBlueprint(*Blueprints::Compile(actor_data));
+}
+
+/**
+ * Creates a new actor from a compiled blueprint
+ * DO NOT USE: This function is for use inside of the scene and actor managers only.
+ * In order to create a new actor please use the "'instantiate' function instead
+ *
+ * @param   blueprint    the blueprint of the actor
+ * @return               returns the id of the newly created actor
+*/
+int Actors::LoadActorWithBlueprint(const ActorBlueprint& blueprint)
+{
+    const int actor_id = AllocateActor(blueprint);
+    const int actor_index = static_cast<int>(IDs.size()) - 1;
     
-    // Assigns the values to the new actor
-    if (actor_data.HasMember("name"))
-    {
-        names.push_back(actor_data["name"].GetString());
-    }
-    else
-    {
-        // Gives this actor a default name if none is specified for it
-        names.push_back("ActorName");
-    }
+    components[actor_index].reserve(blueprint.components.size());
+    component_lookup[actor_index].reserve(blueprint.components.size());
+    component_states[actor_index].reserve(blueprint.components.size());
     
-    if (actor_data.HasMember("enabled"))
-    {
-        actor_enabled.push_back(actor_data["enabled"].GetBool());
-    }
-    else
+    for (const ComponentBlueprint& component_blueprint : blueprint.components)
     {
-        // Sets the actor to be enabled by default
-        actor_enabled.push_back(true);
+        // Add the new component to the "components" vector, it is queued to start if it is enabled
+        std::shared_ptr<sol::table> ptr = CreateComponent(component_blueprint, actor_id);
+        components[actor_index].push_back(ptr);
+        AddComponentState(ptr, actor_id, component_blueprint.type_id, component_blueprint.key_id);
+        
+        // Index the component by its type and key so it can be found without reading its table
+        component_lookup[actor_index].push_back({component_blueprint.type_id, component_blueprint.key_id});
     }
     
-    //-------------------------------------------------------
-    // Components
+    return actor_id;
+}
+
+/**
+ * Creates a new actor from a template
+ * If the template is pooled the actor is reused from its pool when one is free, otherwise it is made from the template's blueprint
+ * DO NOT USE: This function is for use inside of the scene and actor managers only.
+ * In order to create a new actor please use the "'instantiate' function instead
+ *
+ * @param   template_name    the name of the template
+ * @return                   returns the id of the newly created actor
+*/
+int Actors::LoadActorFromTemplate(const std::string& template_name)
+{
+    ActorBlueprint& blueprint = Blueprints::GetTemplateBlueprint(template_name);
+    
+    int pool_id = GetPoolID(blueprint);
+    if (pool_id == -1) { return LoadActorWithBlueprint(blueprint); }
+    
+    if (!pools[pool_id].free_instances.empty()) { return ReuseActor(pool_id); }
+    
+    // The pool is empty, so make a new actor that will join the pool once it is destroyed
+    int actor_id = LoadActorWithBlueprint(blueprint);
+    actor_pools.back() = pool_id;
+    return actor_id;
+}
+
+/**
+ * Creates many actors from a template at once, the same as calling LoadActorFromTemplate "count" times
+ * The blueprint and pool are looked up once and the actor vectors only grow once
+ * DO NOT USE: This function is for use inside of the scene and actor managers only.
+ * In order to create new actors please use the "'instantiate many' function instead
+ *
+ * @param   template_name    the name of the template
+ * @param   count            the number of actors to create
+ * @param   actor_ids        the ids of the new actors are added to the end of this
+*/
+void Actors::LoadActorsFromTemplate(const std::string& template_name, int count, std::vector<int>& actor_ids)
+{
+    if (count <= 0) { return; }
     
-    // Stores all of the created components
-    std::vector<std::shared_ptr<sol::table>> new_components_list;
-    if (actor_data.HasMember("components"))
+    ActorBlueprint& blueprint = Blueprints::GetTemplateBlueprint(template_name);
+    int pool_id = GetPoolID(blueprint);
+    
+    const size_t new_size = IDs.size() + count;
+    IDs.reserve(new_size);
+    name_ids.reserve(new_size);
+    actor_enabled.reserve(new_size);
+    actor_pools.reserve(new_size);
+    components.reserve(new_size);
+    component_lookup.reserve(new_size);
+    component_states.reserve(new_size);
+    components_to_init.reserve(components_to_init.size() + count * blueprint.components.size());
+    actor_ids.reserve(actor_ids.size() + count);
+    
+    for (int i = 0; i < count; i++)
     {
-        const rapidjson::Value& actor_components = actor_data["components"];
+        if (pool_id != -1 && !pools[pool_id].free_instances.empty())
+        {
+            actor_ids.push_back(ReuseActor(pool_id));
+            continue;
+        }
         
-        // Iterate over each component
-        for (rapidjson::Value::ConstMemberIterator itr = actor_components.MemberBegin(); itr != actor_components.MemberEnd(); itr++)
+        actor_ids.push_back(LoadActorWithBlueprint(blueprint));
+        actor_pools.back() = pool_id;
+    }
+}
+
+/**
+ * Fills the pool of every template that sets "prewarm", so the first spawns during the game don't have to make new components
+*/
+void Actors::PrewarmPools()
+{
+    for (const std::string& template_name : GetTemplateNames())
+    {
+        ActorBlueprint& blueprint = Blueprints::GetTemplateBlueprint(template_name);
+        if (blueprint.prewarm <= 0) { continue; }
+        
+        int pool_id = GetPoolID(blueprint);
+        for (int i = 0; i < blueprint.prewarm; i++)
         {
-            // Creates and gets a reference to a new table on the Lua stack
-            sol::table new_component = LuaAPI::GetLuaState()->create_table();
-            
-            // The key of this component
-            std::string key = itr->name.GetString();
-            
-            // Establishes inheritance between the new component and its type if specified
-            if (itr->value.HasMember("type"))
+            // Prewarmed instances don't belong to an actor yet, ReuseActor gives them one
+            std::vector<std::shared_ptr<sol::table>> instance;
+            for (const ComponentBlueprint& component_blueprint : blueprint.components)
             {
-                std::string type = itr->value["type"].GetString();
-                
-                // Establishes our new component according to its type
-                if (ComponentManager::IsComponentTypeNative(type))
-                {
-                    new_component = ComponentManager::NewNativeComponent(type);
-                }
-                else
-                {
-                    ComponentManager::EstablishInheritance(new_component, *GetComponentType(type));
-                }
-                
-                // Allows the component to know its own type
-                new_component["type"] = type;
-                // Gives the component its key
-                new_component["key"] = key;
-                // Sets the component to be enabled by default
-                new_component["enabled"] = true;
-            }
-            // If the type for this component is not specified anywhere, throw an error
-            else
-            {
-                std::cout << "error: component type unspecified for " << key << " on " << names[names.size() - 1];
-                exit(0);
-            }
-            
-            //-------------------------------------------------------
-            // Preform required overrides on component properties
-            // Sets component properties to specified values
-            const rapidjson::Value& component_properties = itr->value;
-            for (rapidjson::Value::ConstMemberIterator itr2 = component_properties.MemberBegin(); itr2 != component_properties.MemberEnd(); itr2++)
-            {
-                std::string property_name = itr2->name.GetString();
-                sol::type property_type = new_component[property_name].get_type();
-
-                sol::lua_value property = "";
-                
-                JsonToLuaObject(property, itr2->value, property_type);
-                
-                new_component[property_name] = property;
+                instance.push_back(CreateComponent(component_blueprint, -1));
             }
+            pools[pool_id].free_instances.push_back(std::move(instance));
+        }
+    }
+}
 
-            //-------------------------------------------------------
-            // Injects the new component with a reference to its actor
-            Actor* _a = new Actor();
-            _a->ID = num_total_actors;
-            new_component["actor"] = _a;
-            
-            // Add the new component to the "components_to_init" and "components" vectors
-            std::shared_ptr<sol::table> ptr = std::make_shared<sol::table>(new_component);
-            components_to_init.push_back(ptr);
-            new_components_list.push_back(ptr);
+/**
+ * Gives a new actor an ID and adds it to the actor vectors, with no components
+ *
+ * @param   blueprint    the blueprint of the actor, only its name and enabled state are read
+ * @returns              the id of the new actor
+*/
+int Actors::AllocateActor(const ActorBlueprint& blueprint)
+{
+    // Gives actor their ID, reusing a freed slot if there is one
+    int slot;
+    if (!free_slots.empty())
+    {
+        slot = free_slots.front();
+        free_slots.pop();
+    }
+    else
+    {
+        slot = static_cast<int>(slots.size());
+        if (slot > ACTOR_SLOT_MASK)
+        {
+            std::cout << "error: too many actors are loaded at once, the most is " << ACTOR_SLOT_MASK + 1 << std::endl;
+            exit(0);
         }
+        slots.emplace_back();
     }
-    components.push_back(new_components_list);
+    const int actor_id = (slots[slot].generation << ACTOR_SLOT_BITS) | slot;
+    slots[slot].index = static_cast<int>(IDs.size());
+    
+    // Assigns the values to the new actor
+    IDs.push_back(actor_id);
+    name_ids.push_back(blueprint.name_id);
+    actor_enabled.push_back(blueprint.enabled);
+    actor_pools.push_back(-1);
+    components.emplace_back();
+    component_lookup.emplace_back();
+    component_states.emplace_back();
     
     // Update the number of loaded actors.
     num_loaded_actors++;
     num_total_actors++;
     
-    return num_total_actors - 1;
+    return actor_id;
+}
+
+/**
+ * Sets the type, key, enabled state, and properties of a component from its blueprint
+ *
+ * @param   component    the component to set up
+ * @param   blueprint    the blueprint of the component
+*/
+void Actors::ApplyComponentBlueprint(sol::table& component, const ComponentBlueprint& blueprint)
+{
+    // Allows the component to know its own type
+    component["type"] = blueprint.type;
+    // Gives the component its key
+    component["key"] = blueprint.key;
+    // Sets the component to be enabled by default
+    component["enabled"] = true;
+    
+    // Preform required overrides on component properties
+    for (const auto& [property_name, property] : blueprint.properties)
+    {
+        component.set(property_name, Blueprints::CopyValue(property));
+    }
+}
+
+/**
+ * Creates a new component from its blueprint
+ *
+ * @param   blueprint    the blueprint of the component
+ * @param   actor_id     the id of the actor the component is on
+ * @returns              the new component
+*/
+std::shared_ptr<sol::table> Actors::CreateComponent(const ComponentBlueprint& blueprint, int actor_id)
+{
+    // Establishes our new component according to its type
+    sol::table new_component;
+    if (blueprint.native_type != -1)
+    {
+        new_component = ComponentManager::NewNativeComponent(blueprint.native_type);
+    }
+    else
+    {
+        // Sized up front for the fields every component gets plus the properties the blueprint sets
+        new_component = LuaAPI::GetLuaState()->create_table(0, static_cast<int>(blueprint.properties.size()) + 4);
+        new_component[sol::metatable_key] = blueprint.metatable;
+    }
+    
+    ApplyComponentBlueprint(new_component, blueprint);
+    
+    // Injects the new component with a reference to its actor
+    Actor* _a = new Actor();
+    _a->ID = actor_id;
+    new_component["actor"] = _a;
+    
+    return std::make_shared<sol::table>(new_component);
+}
+
+/**
+ * Resets a pooled component back to the values a new component would have
+ *
+ * @param   component    the component to reset, native components are replaced with a new one
+ * @param   blueprint    the blueprint of the component
+ * @param   actor_id     the id of the actor the component is on now
+*/
+void Actors::ResetComponent(std::shared_ptr<sol::table>& component, const ComponentBlueprint& blueprint, int actor_id)
+{
+    if (blueprint.native_type != -1)
+    {
+        // Native components can't be cleared like a table can, so a new one takes its place
+        *component = ComponentManager::NewNativeComponent(blueprint.native_type);
+    }
+    else
+    {
+        // Clearing keeps the metatable, so the component still inherits from its type
+        component->clear();
+    }
+    
+    ApplyComponentBlueprint(*component, blueprint);
+    
+    // Scripts can still hold the actor reference from the destroyed instance, so it keeps its dead ID and the component gets a new one
+    // The old reference is never freed since there is no telling when Lua lets go of it, the same as for components made by CreateComponent
+    // So reuse still makes one small allocation per component, but skips the table, the blueprint lookups, and the Lua garbage
+    Actor* _a = new Actor();
+    _a->ID = actor_id;
+    (*component)["actor"] = _a;
+}
+
+/**
+ * Gets the pool of a blueprint, making it the first time a pooled blueprint is used
+ *
+ * @param   blueprint    the blueprint of a template
+ * @returns              the index of the pool in "pools", -1 if the blueprint isn't pooled
+*/
+int Actors::GetPoolID(ActorBlueprint& blueprint)
+{
+    if (!blueprint.pooled || blueprint.pool_id != -1) { return blueprint.pool_id; }
+    
+    blueprint.pool_id = static_cast<int>(pools.size());
+    ActorPool& pool = pools.emplace_back();
+    pool.blueprint = &blueprint;
+    for (const ComponentBlueprint& component_blueprint : blueprint.components)
+    {
+        pool.component_lookup.push_back({component_blueprint.type_id, component_blueprint.key_id});
+    }
+    
+    return blueprint.pool_id;
+}
+
+/**
+ * Creates an actor from an instance in a pool
+ *
+ * @param   pool_id    the pool to take the instance from, must have a free instance
+ * @returns            the id of the new actor
+*/
+int Actors::ReuseActor(int pool_id)
+{
+    ActorPool& pool = pools[pool_id];
+    
+    const int actor_id = AllocateActor(*pool.blueprint);
+    const int actor_index = static_cast<int>(IDs.size()) - 1;
+    
+    actor_pools[actor_index] = pool_id;
+    components[actor_index] = std::move(pool.free_instances.back());
+    component_lookup[actor_index] = pool.component_lookup;
+    pool.free_instances.pop_back();
+    component_states[actor_index].reserve(pool.blueprint->components.size());
+    
+    // Components are in the same order as in the blueprint, reset each one to the blueprint's values
+    // Each one gets a new record, so entries left in the lifecycle lists from its last use stay dead
+    for (size_t i = 0; i < pool.blueprint->components.size(); i++)
+    {
+        ResetComponent(components[actor_index][i], pool.blueprint->components[i], actor_id);
+        AddComponentState(components[actor_index][i], actor_id, pool.blueprint->components[i].type_id, pool.blueprint->components[i].key_id);
+    }
+    
+    return actor_id;
 }
 
 /**
@@ -476,11 +925,39 @@ void Actors::PrepareActorForDestruction(int actor_id)
     int actor_index = GetIndex(actor_id);
     if (actor_index == -1) {return;}
     
+    // Only returned to its pool once, even if the actor is destroyed more than once this frame
+    int pool_id = actor_pools[actor_index];
+    actor_pools[actor_index] = -1;
+    
     // Queues all of the components on the given actor for deletion
-    std::vector<std::shared_ptr<sol::table>> components_to_remove = components[actor_index];
-    for (auto& component : components_to_remove)
+    // Every component is going, so there is no need to search for and erase them one at a time like RemoveComponentFromActor does
+    for (auto& state : component_states[actor_index])
+    {
+        // Every entry for the component in the lifecycle lists is dropped the next time the list is run
+        state->removed = true;
+        state->activation++;
+        
+        (*state->component)["REMOVED_FROM_ACTOR"] = true;
+        components_to_delete.push_back({state, pool_id != -1});
+    }
+    
+    if (pool_id != -1) { pending_pool_returns.emplace_back(pool_id, std::move(components[actor_index])); }
+    components[actor_index].clear();
+    component_lookup[actor_index].clear();
+    component_states[actor_index].clear();
+}
+
+/**
+ * Prepares many actors for destruction later this frame in a single pass
+ * DO NOT USE: This function is for use inside of the scene and actor managers only.
+ *
+ * @param   actor_ids    the ids of the actors to prepare, ids of actors that don't exist are skipped
+*/
+void Actors::PrepareActorsForDestruction(const std::vector<int>& actor_ids)
+{
+    for (int actor_id : actor_ids)
     {
-        RemoveComponentFromActor(actor_id, *component);
+        PrepareActorForDestruction(actor_id);
     }
 }
 
@@ -496,27 +973,56 @@ void Actors::DestroyActor(int actor_id)
     int actor_index = GetIndex(actor_id);
     if (actor_index == -1) {return;}
     
-    IDs[actor_index] = -1;
-    actor_enabled[actor_index] = false;
-    id_to_index.erase(actor_id);
+    // Move the last actor into the destroyed actor's place so the vectors stay packed
+    int last_index = static_cast<int>(IDs.size()) - 1;
+    if (actor_index != last_index)
+    {
+        IDs[actor_index] = IDs[last_index];
+        name_ids[actor_index] = name_ids[last_index];
+        actor_enabled[actor_index] = actor_enabled[last_index];
+        actor_pools[actor_index] = actor_pools[last_index];
+        components[actor_index] = std::move(components[last_index]);
+        component_lookup[actor_index] = std::move(component_lookup[last_index]);
+        component_states[actor_index] = std::move(component_states[last_index]);
+        
+        slots[IDs[actor_index] & ACTOR_SLOT_MASK].index = actor_index;
+    }
+    IDs.pop_back();
+    name_ids.pop_back();
+    actor_enabled.pop_back();
+    actor_pools.pop_back();
+    components.pop_back();
+    component_lookup.pop_back();
+    component_states.pop_back();
+    
+    // Free the slot, bumping the generation makes every existing copy of this ID invalid
+    ActorSlot& actor_slot = slots[actor_id & ACTOR_SLOT_MASK];
+    actor_slot.index = -1;
+    actor_slot.generation = (actor_slot.generation + 1) & ACTOR_GENERATION_MASK;
+    free_slots.push(actor_id & ACTOR_SLOT_MASK);
+    
     num_loaded_actors--;
 }
 
 /**
- * Gets the vector index of the actor with the given ID
+ * Destroys many actors at once
+ * DO NOT USE: This function is for use inside of the scene and actor managers only.
  *
- * @param   actor_id    the id of the actor that this function is acting on
+ * @param   actor_ids    the ids of the actors to destroy, ids of actors that don't exist are skipped
 */
-int Actors::GetIndex(int actor_id)
+void Actors::DestroyActors(const std::vector<int>& actor_ids)
 {
-    // Check if its an actor that exists
-    if (id_to_index.find(actor_id) != id_to_index.end() && id_to_index[actor_id] != -1)
+    for (int actor_id : actor_ids)
     {
-        return id_to_index[actor_id];
+        DestroyActor(actor_id);
     }
     
-    //std::cout << "error: attempt to access a nonexistant actor with ID: " << actor_id << std::endl;
-    return -1;
+    // "OnDestroy" has been called for every component by now, so the instances can be reused
+    for (auto& [pool_id, instance] : pending_pool_returns)
+    {
+        pools[pool_id].free_instances.push_back(std::move(instance));
+    }
+    pending_pool_returns.clear();
 }
 
 //-------------------------------------------------------
@@ -540,18 +1046,26 @@ void Actors::RemoveComponentFromActor(int actor_id, sol::table component)
     
     // Removes this component from the actor
     int component_index = -1;
-    for (int i = 0; i < components[actor_index].size(); i++) // Find the index of this component
+    for (int i = 0; i < static_cast<int>(components[actor_index].size()); i++) // Find the index of this component
     {
         if ((*components[actor_index][i]).pointer() == component.pointer())
         {
+            std::shared_ptr<ComponentState>& state = component_states[actor_index][i];
+            state->removed = true;
+            state->activation++;
+            
             (component)["REMOVED_FROM_ACTOR"] = true;
-            components_to_delete.push(std::make_shared<sol::table>(component));
+            components_to_delete.push_back({state, false});
             component_index = i;
             break;
         }
     }
     if (component_index != -1) {
+        // The actor no longer matches its template, so it can't go back to its pool
+        actor_pools[actor_index] = -1;
         components[actor_index].erase(components[actor_index].begin() + component_index);
+        component_lookup[actor_index].erase(component_lookup[actor_index].begin() + component_index);
+        component_states[actor_index].erase(component_states[actor_index].begin() + component_index);
     } // remove the component from the actor
 }
 
@@ -562,23 +1076,45 @@ void Actors::RemoveComponentFromActor(int actor_id, sol::table component)
  * @param   type        the type of component we're searching for
  * @return              the first component on the given actor with the given type, if none are found returns null
 */
-sol::table Actors::GetComponentByType(int actor_id, std::string type)
+sol::table Actors::GetComponentByType(int actor_id, std::string_view type)
+{
+    // A type that was never interned can't be on any component
+    int type_id = StringTable::Find(type);
+    if (type_id == -1) {return sol::table();}
+    
+    return GetComponentByTypeID(actor_id, type_id);
+}
+
+/**
+ * Same as GetComponentByType, but takes a type ID from GetComponentTypeID so no string has to be hashed
+ *
+ * @param   actor_id    the id of the actor that this function is acting on
+ * @param   type_id     the ID of the type of component we're searching for
+ * @return              the first component on the given actor with the given type, if none are found returns null
+*/
+sol::table Actors::GetComponentByTypeID(int actor_id, int type_id)
 {
     sol::table null; // An empty table, to be returned if the component(s) cannot be found
     
     int actor_index = GetIndex(actor_id);
-    if (actor_index == -1) {return null;}
+    if (actor_index == -1 || type_id < 0) {return null;}
     
-    for (int i = 0; i < components[actor_index].size(); i++)
-    {
-        if ((*components[actor_index][i])["type"] == type)
-        {
-            return *components[actor_index][i];
-        }
-    }
+    int i = FindComponent(actor_index, type_id, -1);
+    if (i == -1) {return null;}
     
-    // Return null if the component cannot be found.
-    return null;
+    return *components[actor_index][i];
+}
+
+/**
+ * Gets the ID of a component type, for code that searches for the same type often
+ * The ID stays the same for the whole run, so it can be looked up once and kept
+ *
+ * @param   type    the name of the component type
+ * @return          the ID of the component type
+*/
+int Actors::GetComponentTypeID(std::string_view type)
+{
+    return StringTable::Intern(type);
 }
 
 /**
@@ -589,7 +1125,10 @@ sol::table Actors::GetComponentByType(int actor_id, std::string type)
 */
 int Actors::GetNumberOfComponents(int actor_id)
 {
-    return components[GetIndex(actor_id)].size();
+    int actor_index = GetIndex(actor_id);
+    if (actor_index == -1) {return 0;}
+    
+    return static_cast<int>(components[actor_index].size());
 }
 
 /**
@@ -601,7 +1140,27 @@ int Actors::GetNumberOfComponents(int actor_id)
 */
 sol::table Actors::GetComponentByIndex(int actor_id, int component_index)
 {
-    return *components[GetIndex(actor_id)][component_index];
+    sol::table null; // An empty table, to be returned if the component cannot be found
+    
+    int actor_index = GetIndex(actor_id);
+    if (actor_index == -1 || component_index < 0 || component_index >= static_cast<int>(components[actor_index].size())) {return null;}
+    
+    return *components[actor_index][component_index];
+}
+
+/**
+* Gets the record of a component by index
+*
+* @param     actor_id           the id of the actor that this function is acting on
+* @param     component_index    the index of the component
+* @return    the record of the component, nullptr if the component cannot be found
+*/
+ComponentState* Actors::GetComponentStateByIndex(int actor_id, int component_index)
+{
+    int actor_index = GetIndex(actor_id);
+    if (actor_index == -1 || component_index < 0 || component_index >= static_cast<int>(component_states[actor_index].size())) {return nullptr;}
+    
+    return component_states[actor_index][component_index].get();
 }
 
 /**
@@ -612,7 +1171,70 @@ sol::table Actors::GetComponentByIndex(int actor_id, int component_index)
 */
 bool Actors::GetActorEnabled(int actor_id)
 {
-    return actor_enabled[GetIndex(actor_id)];
+    int actor_index = GetIndex(actor_id);
+    if (actor_index == -1) {return false;}
+    
+    return actor_enabled[actor_index];
+}
+
+/**
+* Enables or disables an actor, the components of a disabled actor aren't updated
+* 
+* @param     actor_id    the id of the actor that this function is acting on
+* @param     enabled     whether the actor should be enabled
+*/
+void Actors::SetActorEnabled(int actor_id, bool enabled)
+{
+    int actor_index = GetIndex(actor_id);
+    if (actor_index == -1 || actor_enabled[actor_index] == enabled) {return;}
+    
+    actor_enabled[actor_index] = enabled;
+    for (auto& state : component_states[actor_index])
+    {
+        UpdateActivation(state);
+    }
+}
+
+/**
+* Enables or disables a component, disabled components aren't updated
+* Components must be enabled and disabled through this instead of setting "enabled" on them
+* 
+* @param     actor_id     the id of the actor that this function is acting on
+* @param     component    the component on the actor
+* @param     enabled      whether the component should be enabled
+*/
+void Actors::SetComponentEnabled(int actor_id, sol::table component, bool enabled)
+{
+    int actor_index = GetIndex(actor_id);
+    if (actor_index == -1 || !component.valid()) {return;}
+    
+    for (int i = 0; i < static_cast<int>(components[actor_index].size()); i++) // Find the index of this component
+    {
+        if ((*components[actor_index][i]).pointer() != component.pointer()) { continue; }
+        
+        // Still set on the component, since scripts and the collision callbacks read it
+        component["enabled"] = enabled;
+        
+        std::shared_ptr<ComponentState>& state = component_states[actor_index][i];
+        state->enabled = enabled;
+        UpdateActivation(state);
+        return;
+    }
+}
+
+/**
+* Pauses or resumes "OnUpdate" for every component in an execution group (see "update_group")
+* 
+* @param     group      the name of the execution group
+* @param     enabled    whether the group should run
+*/
+void Actors::SetUpdateGroupEnabled(const std::string& group, bool enabled)
+{
+    int group_id = StringTable::Intern(group);
+    auto found = std::find(disabled_update_groups.begin(), disabled_update_groups.end(), group_id);
+    
+    if (enabled && found != disabled_update_groups.end()) { disabled_update_groups.erase(found); }
+    else if (!enabled && found == disabled_update_groups.end()) { disabled_update_groups.push_back(group_id); }
 }
 
 /**
@@ -622,7 +1244,7 @@ bool Actors::GetActorEnabled(int actor_id)
  * @param   type        the type of component we're searching for
  * @return              a list of all the components with the given type, if none are found returns null
 */
-sol::table Actors::GetComponentsByType(int actor_id, std::string type)
+sol::table Actors::GetComponentsByType(int actor_id, std::string_view type)
 {
     sol::table null; // An empty table, to be returned if the component(s) cannot be found
     
@@ -633,11 +1255,16 @@ sol::table Actors::GetComponentsByType(int actor_id, std::string type)
     components_of_type[0] = null;
     int index = 1;
     
-    for (int i = 0; i < components[actor_index].size(); i++)
+    int type_id = StringTable::Find(type);
+    if (type_id == -1) {return components_of_type;}
+    
+    const std::vector<ComponentIndexEntry>& entries = component_lookup[actor_index];
+    for (int i = 0; i < static_cast<int>(entries.size()); i++)
     {
-        if ((*components[actor_index][i])["type"] == type)
+        if (entries[i].type_id == type_id)
         {
             components_of_type[index] = *components[actor_index][i];
+            index++;
         }
     }
     
@@ -651,21 +1278,16 @@ sol::table Actors::GetComponentsByType(int actor_id, std::string type)
  * @param   key         the key of the component we're searching for
  * @return              the component on the given actor with the given key, if none are found returns null
 */
-sol::table Actors::GetComponentByKey(int actor_id, std::string key)
+sol::table Actors::GetComponentByKey(int actor_id, std::string_view key)
 {
     sol::table null; // An empty table, to be returned if the component(s) cannot be found
     
     int actor_index = GetIndex(actor_id);
-    if (actor_index == -1) {return null;}
+    int key_id = StringTable::Find(key);
+    if (actor_index == -1 || key_id == -1) {return null;}
     
-    for (int i = 0; i < components[actor_index].size(); i++)
-    {
-        if ((*components[actor_index][i])["key"] == key)
-        {
-            return *components[actor_index][i];
-        }
-    }
+    int i = FindComponent(actor_index, -1, key_id);
+    if (i == -1) {return null;}
     
-    // Return null if the component cannot be found.
-    return null;
+    return *components[actor_index][i];
 }
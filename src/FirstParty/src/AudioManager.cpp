@@ -23,6 +23,8 @@
 void AudioManager::AudioPlay(const int channel, const std::string& clip_name, const int num_loops)
 {
     Mix_Chunk* mix_chunk = GetSound(clip_name);
+    if (mix_chunk == nullptr) { return; } // Sounds aren't loaded when running headless
+    
     if (Mix_PlayChannel(channel, mix_chunk, num_loops) == -1) {
         std::cout << Mix_GetError();
     }
@@ -6,6 +6,7 @@
 //  Handles contact between physics bodies
 
 #include "CollisionDetector.h"
+#include "ScriptProfiler.h"
 
 /**
 * Handles physics contacts when the contact first occurs
@@ -14,6 +15,8 @@
 */
 void CollisionDetector::BeginContact(b2Contact* contact)
 {
+	TRACE_ZONE("physics", "BeginContact");
+
 	b2Fixture* fixture_a = contact->GetFixtureA();
 	b2Fixture* fixture_b = contact->GetFixtureB();
 	uintptr_t userDataA = fixture_a->GetUserData().pointer;
@@ -67,6 +70,8 @@ void CollisionDetector::BeginContact(b2Contact* contact)
 */
 void CollisionDetector::EndContact(b2Contact* contact)
 {
+	TRACE_ZONE("physics", "EndContact");
+
 	b2Fixture* fixture_a = contact->GetFixtureA();
 	b2Fixture* fixture_b = contact->GetFixtureB();
 	uintptr_t userDataA = fixture_a->GetUserData().pointer;
@@ -134,8 +139,11 @@ void OnEnter::OnTriggerEnter(const Collision& collision)
 				continue;
 			}
 
-			if (OnTriggerEnter.valid())
+			ComponentState* state = Actors::GetComponentStateByIndex(collision.this_actor_id, static_cast<int>(i));
+			if (OnTriggerEnter.valid() && state != nullptr)
 			{
+				ScriptProfileScope profile_scope(state->type_id, state->key_id, SCRIPT_CALLBACK_ON_TRIGGER_ENTER, collision.this_actor_id);
+				RunningComponentScope running_scope(state); // Coroutines started here belong to the component
 				OnTriggerEnter(component, collision);
 			}
 		}
@@ -177,8 +185,11 @@ void OnEnter::OnTriggerExit(const Collision& collision)
 				continue;
 			}
 
-			if (OnTriggerExit.valid())
+			ComponentState* state = Actors::GetComponentStateByIndex(collision.this_actor_id, static_cast<int>(i));
+			if (OnTriggerExit.valid() && state != nullptr)
 			{
+				ScriptProfileScope profile_scope(state->type_id, state->key_id, SCRIPT_CALLBACK_ON_TRIGGER_EXIT, collision.this_actor_id);
+				RunningComponentScope running_scope(state); // Coroutines started here belong to the component
 				OnTriggerExit(component, collision);
 			}
 		}
@@ -220,8 +231,11 @@ void OnEnter::OnCollisionEnter(const Collision& collision)
 				continue;
 			}
 
-			if (OnCollisionEnter.valid())
+			ComponentState* state = Actors::GetComponentStateByIndex(collision.this_actor_id, static_cast<int>(i));
+			if (OnCollisionEnter.valid() && state != nullptr)
 			{
+				ScriptProfileScope profile_scope(state->type_id, state->key_id, SCRIPT_CALLBACK_ON_COLLISION_ENTER, collision.this_actor_id);
+				RunningComponentScope running_scope(state); // Coroutines started here belong to the component
 				OnCollisionEnter(component, collision);
 			}
 		}
@@ -263,8 +277,11 @@ void OnEnter::OnCollisionExit(const Collision& collision)
 				continue;
 			}
 
-			if (OnCollisionExit.valid())
+			ComponentState* state = Actors::GetComponentStateByIndex(collision.this_actor_id, static_cast<int>(i));
+			if (OnCollisionExit.valid() && state != nullptr)
 			{
+				ScriptProfileScope profile_scope(state->type_id, state->key_id, SCRIPT_CALLBACK_ON_COLLISION_EXIT, collision.this_actor_id);
+				RunningComponentScope running_scope(state); // Coroutines started here belong to the component
 				OnCollisionExit(component, collision);
 			}
 		}
@@ -12,10 +12,6 @@
 #include "ActorManager.h"
 #include "LuaAPI.h"
 
-#include "Rigidbody.h"
-#include "SpriteRenderer.h"
-#include "ParticleSystem.h"
-
 /**
  * Establishes inheritance between two tables by setting one to be the metatable of the other
  *
@@ -35,54 +31,38 @@ void ComponentManager::EstablishInheritance(sol::table& instance_table, sol::tab
 //-------------------------------------------------------
 // Native Components
 
+/**
+ * @returns    the Lua state, the registry can't include LuaAPI.h since it includes this
+ */
+sol::state& ComponentManager::GetLuaState()
+{
+    return *LuaAPI::GetLuaState();
+}
+
 /**
  * Returns true if the given type is a C++ based component
  *
  *  @param    type    the type to confirm if its native or not
  *  @returns          true if the given type is a native component, and false otherwise
  */
-bool ComponentManager::IsComponentTypeNative(std::string type)
+bool ComponentManager::IsComponentTypeNative(std::string_view type)
 {
-    if (type == "Rigidbody") {return true;}
-    if (type == "SpriteRenderer") {return true;}
-    if (type == "ParticleSystem") {return true;}
-    
-    return false;
+    return GetNativeComponentType(StringTable::Find(type)) != -1;
 }
 
 /**
  * Creates and returns a new native component of the given type
  *
- *  @param    component_type    the component type to create a new copy of
- *  @returns                    the table that contains our new native component
+ *  @param    native_type    the native type ID of the component type to create a new copy of
+ *  @returns                 the table that contains our new native component
  */
-sol::table ComponentManager::NewNativeComponent(std::string component_type)
+sol::table ComponentManager::NewNativeComponent(int native_type)
 {
-    if (component_type == "Rigidbody")
-    {
-        Rigidbody rigidbody;
-        sol::object r = sol::make_object(*LuaAPI::GetLuaState(), rigidbody);
-        sol::table new_component = r;
-        
-        return new_component;
-    }
-    if (component_type == "SpriteRenderer")
-    {
-        SpriteRenderer sprite_renderer;
-        sol::object r = sol::make_object(*LuaAPI::GetLuaState(), sprite_renderer);
-        sol::table new_component = r;
-        
-        return new_component;
-    }
-    if (component_type == "ParticleSystem")
+    if (native_type < 0 || native_type >= static_cast<int>(native_types.size()))
     {
-        ParticleSystem particle_system;
-        sol::object r = sol::make_object(*LuaAPI::GetLuaState(), particle_system);
-        sol::table new_component = r;
-        
-        return new_component;
+        sol::table null;
+        return null;
     }
     
-    sol::table null;
-    return null;
+    return native_types[native_type].create();
 }
@@ -0,0 +1,330 @@
+//
+//  Coroutines.cpp
+//  wolverine_engine
+//
+//  Runs Lua coroutines started by scripts, waking each one only when what it is waiting for happens
+//
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "Coroutines.h"
+#include "ActorManager.h"
+#include "LuaAPI.h"
+#include "Profiler.h"
+#include "StringTable.h"
+#include "TimeManager.h"
+
+/**
+ * Adds an entry to the wheel
+ *
+ * @param    due_tick        the tick the entry is due on, entries due before the next tick are due on the next tick
+ * @param    coroutine_id    the coroutine waiting
+ * @returns                  the tick the entry was added on, for Remove
+ */
+long long TimerWheel::Add(long long due_tick, int coroutine_id)
+{
+    due_tick = std::max(due_tick, next_tick);
+    slots[due_tick % slots.size()].emplace_back(due_tick, coroutine_id);
+    return due_tick;
+}
+
+/**
+ * Takes an entry out of the wheel before it is due, does nothing if it already came due
+ *
+ * @param    due_tick        the tick Add returned for the entry
+ * @param    coroutine_id    the coroutine waiting
+ */
+void TimerWheel::Remove(long long due_tick, int coroutine_id)
+{
+    if (due_tick < next_tick) { return; }
+
+    // Erased instead of swapped out so the entries left in the slot are still resumed in the order they were added
+    std::vector<std::pair<long long, int>>& slot = slots[due_tick % slots.size()];
+    auto entry = std::find(slot.begin(), slot.end(), std::make_pair(due_tick, coroutine_id));
+    if (entry != slot.end()) { slot.erase(entry); }
+}
+
+/**
+ * Takes every entry due on or before a tick out of the wheel
+ *
+ * @param    tick    the current tick
+ * @param    due     the coroutines that are due are added to the end of this
+ */
+void TimerWheel::Advance(long long tick, std::vector<int>& due)
+{
+    if (tick < next_tick) { return; }
+
+    // After a long frame more ticks can pass than there are slots, every slot only has to be looked at once
+    long long num_ticks = std::min(tick - next_tick + 1, static_cast<long long>(slots.size()));
+    for (long long i = 0; i < num_ticks; i++)
+    {
+        std::vector<std::pair<long long, int>>& slot = slots[(next_tick + i) % slots.size()];
+
+        // Entries due on a later turn of the wheel are kept, in place
+        size_t num_kept = 0;
+        for (size_t j = 0; j < slot.size(); j++)
+        {
+            if (slot[j].first <= tick) { due.push_back(slot[j].second); }
+            else { slot[num_kept++] = slot[j]; }
+        }
+        slot.resize(num_kept);
+    }
+
+    next_tick = tick + 1;
+}
+
+/**
+ * Resumes every coroutine that is due this frame, call once per frame after the components update
+ */
+void Coroutines::Update()
+{
+    ProfileScope scope(PROFILER_PHASE_COROUTINES);
+
+    frame_wheel.Advance(frame, ready);
+    time_wheel.Advance(static_cast<long long>(std::floor(Time::GetTime() * time_ticks_per_second)), ready);
+
+    // Coroutines woken while these run (ex: by an event) are resumed next frame
+    resuming.swap(ready);
+    for (int coroutine_id : resuming)
+    {
+        Resume(coroutine_id);
+    }
+    resuming.clear();
+
+    frame++;
+}
+
+/**
+ * Starts a coroutine, it runs right away until it first waits
+ * If called from a component's lifecycle function the coroutine belongs to that component, and is stopped once the component is removed
+ *
+ * @param    function    the function to run as a coroutine
+ * @param    args        passed to the function
+ * @returns              the handle of the coroutine, for Engine.StopCoroutine
+ */
+int Coroutines::StartCoroutine(sol::function function, sol::variadic_args args)
+{
+    int coroutine_id = next_id++;
+    CoroutineRecord& record = coroutines[coroutine_id];
+
+    record.thread = sol::thread::create(LuaAPI::GetLuaState()->lua_state());
+    record.routine = sol::coroutine(record.thread.thread_state(), function);
+
+    ComponentState* owner = Actors::GetRunningComponent();
+    if (owner)
+    {
+        record.owner = owner->weak_from_this();
+        record.has_owner = true;
+        owner->coroutines.push_back(coroutine_id);
+    }
+
+    record.running = true;
+    sol::protected_function_result result = record.routine(args);
+    Schedule(coroutine_id, result);
+
+    return coroutine_id;
+}
+
+/**
+ * Stops a coroutine, it is never resumed again
+ *
+ * @param    coroutine_id    the handle of the coroutine, handles of coroutines that already finished are ignored
+ */
+void Coroutines::StopCoroutine(int coroutine_id)
+{
+    auto found = coroutines.find(coroutine_id);
+    if (found == coroutines.end()) { return; }
+
+    // A running coroutine can't be thrown away until it yields, its thread is still in use
+    if (found->second.running) { found->second.stopped = true; }
+    else { Erase(found); }
+}
+
+/**
+ * Stops every coroutine a component started, called once the component is removed
+ *
+ * @param    component    the component
+ */
+void Coroutines::StopComponentCoroutines(ComponentState& component)
+{
+    // Erase takes each one out of the component's list, so the list can't be iterated directly
+    std::vector<int> owned;
+    owned.swap(component.coroutines);
+    for (int coroutine_id : owned)
+    {
+        StopCoroutine(coroutine_id);
+    }
+}
+
+/**
+ * Wakes every coroutine waiting for an event, they are resumed the next time Update runs (this frame if it hasn't yet)
+ *
+ * @param    event_name    the name of the event
+ */
+void Coroutines::RaiseEvent(const std::string& event_name)
+{
+    int event_id = StringTable::Find(event_name);
+    if (event_id == -1) { return; } // Nothing has ever waited for it
+
+    auto found = event_waiters.find(event_id);
+    if (found == event_waiters.end()) { return; }
+
+    for (int coroutine_id : found->second)
+    {
+        coroutines[coroutine_id].waiting = false;
+    }
+    ready.insert(ready.end(), found->second.begin(), found->second.end());
+    found->second.clear();
+}
+
+/**
+ * Resumes a coroutine that is due, unless it was stopped or its owner was removed
+ *
+ * @param    coroutine_id    the handle of the coroutine
+ */
+void Coroutines::Resume(int coroutine_id)
+{
+    auto found = coroutines.find(coroutine_id);
+    if (found == coroutines.end()) { return; }
+
+    // It was taken out of the wheel it was in when it came due
+    CoroutineRecord& record = found->second;
+    record.waiting = false;
+
+    std::shared_ptr<ComponentState> owner = record.owner.lock();
+    if (record.has_owner && (!owner || owner->removed))
+    {
+        Erase(found);
+        return;
+    }
+
+    // Coroutines started by this one belong to the same component
+    ComponentState* running_component = Actors::GetRunningComponent();
+    Actors::SetRunningComponent(owner.get());
+
+    record.running = true;
+    sol::protected_function_result result = record.routine();
+
+    Actors::SetRunningComponent(running_component);
+    Schedule(coroutine_id, result);
+}
+
+/**
+ * Puts a coroutine that was just resumed in the wheel or event list for what it yielded, or removes it if it finished
+ *
+ * @param    coroutine_id    the handle of the coroutine
+ * @param    result          what resuming the coroutine returned
+ */
+void Coroutines::Schedule(int coroutine_id, const sol::protected_function_result& result)
+{
+    // Records don't move when others are added, so this is still the coroutine that was resumed
+    auto found = coroutines.find(coroutine_id);
+    CoroutineRecord& record = found->second;
+    record.running = false;
+
+    if (!result.valid())
+    {
+        sol::error error = result;
+        PrintError(record, error.what());
+        Erase(found);
+        return;
+    }
+
+    // Finished, stopped while it was running, or its owner was removed while it was running (ex: it destroyed its own actor)
+    std::shared_ptr<ComponentState> owner = record.owner.lock();
+    if (record.stopped || result.status() != sol::call_status::yielded || (record.has_owner && (!owner || owner->removed)))
+    {
+        Erase(found);
+        return;
+    }
+
+    // A yield without a wait (coroutine.yield()) waits one frame
+    COROUTINE_WAIT wait = COROUTINE_WAIT_FRAMES;
+    if (result.return_count() >= 2 && result.get_type(0) == sol::type::number) { wait = static_cast<COROUTINE_WAIT>(result.get<int>(0)); }
+
+    record.waiting = true;
+    record.wait = wait;
+    switch (wait)
+    {
+        case COROUTINE_WAIT_SECONDS:
+        {
+            double due_time = Time::GetTime() + result.get<double>(1);
+            record.due_tick = time_wheel.Add(static_cast<long long>(std::ceil(due_time * time_ticks_per_second)), coroutine_id);
+            break;
+        }
+        case COROUTINE_WAIT_EVENT:
+        {
+            record.event_id = StringTable::Intern(result.get<std::string>(1));
+            event_waiters[record.event_id].push_back(coroutine_id);
+            break;
+        }
+        default:
+        {
+            record.wait = COROUTINE_WAIT_FRAMES;
+            int num_frames = result.return_count() >= 2 ? std::max(result.get<int>(1), 1) : 1;
+            record.due_tick = frame_wheel.Add(frame + num_frames, coroutine_id);
+            break;
+        }
+    }
+}
+
+/**
+ * Throws a coroutine away, taking it out of whatever it is waiting for and its owner's list of coroutines
+ * Coroutines that are running can't be thrown away until they yield, see CoroutineRecord::stopped
+ *
+ * @param    found    the coroutine
+ */
+void Coroutines::Erase(std::unordered_map<int, CoroutineRecord>::iterator found)
+{
+    int coroutine_id = found->first;
+    CoroutineRecord& record = found->second;
+
+    if (record.waiting)
+    {
+        switch (record.wait)
+        {
+            case COROUTINE_WAIT_SECONDS: time_wheel.Remove(record.due_tick, coroutine_id); break;
+            case COROUTINE_WAIT_FRAMES: frame_wheel.Remove(record.due_tick, coroutine_id); break;
+            case COROUTINE_WAIT_EVENT:
+            {
+                auto waiters = event_waiters.find(record.event_id);
+                if (waiters == event_waiters.end()) { break; }
+                
+                std::vector<int>& ids = waiters->second;
+                ids.erase(std::remove(ids.begin(), ids.end(), coroutine_id), ids.end());
+                break;
+            }
+        }
+    }
+
+    // Coroutines stopped along with their owner were already taken out of its list
+    std::shared_ptr<ComponentState> owner = record.owner.lock();
+    if (owner)
+    {
+        std::vector<int>& owned = owner->coroutines;
+        auto entry = std::find(owned.begin(), owned.end(), coroutine_id);
+        if (entry != owned.end()) { owned.erase(entry); }
+    }
+
+    coroutines.erase(found);
+}
+
+/**
+ * Prints an error from a coroutine
+ *
+ * @param    record     the coroutine
+ * @param    message    the error
+ */
+void Coroutines::PrintError(const CoroutineRecord& record, const std::string& message)
+{
+    std::string errorMessage = message;
+#ifdef _WIN32
+    std::replace(errorMessage.begin(), errorMessage.end(), '\\', '/');
+#endif
+
+    std::shared_ptr<ComponentState> owner = record.owner.lock();
+    std::string name = owner ? Actors::GetName(owner->actor_id) : "Coroutine";
+    std::cout << "\033[31m" << name << " : " << errorMessage << "\033[0m" << std::endl;
+}
@@ -16,6 +16,8 @@
 #include <cstdlib>
 #include <unordered_map>
 #include <map>
+#include <future>
+#include <tuple>
 
 #include "EngineUtils.h"
 
@@ -25,6 +27,9 @@
 #include "TemplateDB.h"
 #include "SceneDB.h"
 #include "LuaAPI.h"
+#include "Tracer.h"
+#include "WorkerPool.h"
+#include "StringTable.h"
 
 #include "Engine.h"
 
@@ -36,14 +41,22 @@ std::unordered_map<std::string, rapidjson::Document*> loaded_templates; // All o
 std::unordered_map<std::string, std::shared_ptr<sol::table>> loaded_component_types; // All of the loaded component types
 std::unordered_map<std::string, std::string> loaded_scene_paths; // All of the loaded scene paths
 
+// Resources that are still being loaded on the worker pool
+std::vector<std::pair<std::string, std::future<SDL_Surface*>>> pending_images; // Decoded images waiting to be turned into textures
+std::vector<std::pair<std::string, std::future<Mix_Chunk*>>> pending_sounds; // Sounds being decoded
+std::vector<std::tuple<std::string, std::string, std::future<rapidjson::Document*>>> pending_templates; // Templates being parsed, with the path they are read from
+
 //-------------------------------------------------------
 // Image Database
 
 /**
- * Loads all of the images in the resources/images directory
+ * Starts decoding all of the images in the resources/images directory on the worker pool
+ * When headless only the names are registered, there is no renderer to create textures with
 */
-void LoadImages()
+void StartLoadingImages()
 {
+    TRACE_ZONE("assets", "StartLoadingImages");
+    
     /* Load files from this path */
     const std::string path = "resources/images";
     
@@ -54,12 +67,59 @@ void LoadImages()
         {
             if (file.path() != path + "/.DS_Store")
             {
-                SDL_Renderer* r = RendererData::GetRenderer();
-                SDL_Texture* img = IMG_LoadTexture(r, file.path().string().c_str());
-                loaded_images[file.path().filename().stem().stem().string()] = img;
+                std::string image_name = file.path().filename().stem().stem().string();
+                
+                if (RendererData::IsHeadless())
+                {
+                    loaded_images[image_name] = nullptr;
+                    continue;
+                }
+                
+                // Decoding only needs the CPU, the texture is created later on the main thread
+                std::string file_path = file.path().string();
+                pending_images.emplace_back(image_name, WorkerPool::Submit([file_path]() {
+                    TRACE_ZONE_NAMED(file_zone, "assets", "DecodeImage");
+                    TRACE_ZONE_ARGS(file_zone, "\"file\":\"" + Tracer::Escape(file_path) + "\"");
+                    
+                    return IMG_Load(file_path.c_str());
+                }));
             }
         }
     }
+} // StartLoadingImages()
+
+/**
+ * Waits for the images started by StartLoadingImages and turns them into textures
+ * Must be called on the main thread after the renderer has been initialized
+*/
+void FinishLoadingImages()
+{
+    TRACE_ZONE("assets", "FinishLoadingImages");
+    
+    for (auto& [image_name, decoded_image] : pending_images)
+    {
+        SDL_Surface* surface = decoded_image.get();
+        if (surface == nullptr)
+        {
+            loaded_images[image_name] = nullptr;
+            continue;
+        }
+        
+        TRACE_ZONE("assets", "UploadImage");
+        loaded_images[image_name] = SDL_CreateTextureFromSurface(RendererData::GetRenderer(), surface);
+        SDL_FreeSurface(surface);
+    }
+    pending_images.clear();
+} // FinishLoadingImages()
+
+/**
+ * Loads all of the images in the resources/images directory
+ * When headless only the names are registered, there is no renderer to create textures with
+*/
+void LoadImages()
+{
+    StartLoadingImages();
+    FinishLoadingImages();
 } // LoadImages()
 
 /**
@@ -79,32 +139,92 @@ SDL_Texture* GetImage(std::string image_name)
     return loaded_images[image_name];
 } // GetImage()
 
+/**
+ * Adds an image to the database without loading it from resources/images
+ * Used by tools that build their scenes in memory (wolverine-bench)
+ *
+ * @param    image_name    the name the image can be found with
+ * @param    image         the texture to store, can be nullptr when headless
+ */
+void AddImage(const std::string& image_name, SDL_Texture* image)
+{
+    loaded_images[image_name] = image;
+} // AddImage()
+
 //-------------------------------------------------------
 // Audio Database
 
 /**
- * Loads all of the audio in the resources/audio directory
+ * Starts decoding all of the audio in the resources/audio directory on the worker pool
+ * When headless only the names are registered and the audio device is never opened
 */
-void LoadSounds()
+void StartLoadingSounds()
 {
+    TRACE_ZONE("assets", "StartLoadingSounds");
+    
     /* Load files from this path */
     const std::string path = "resources/audio";
     
     // Fills up the database if the path exists
     if (FileUtils::DirectoryExists(path))
     {
+        bool audio_opened = false;
+        
         for (const auto& file : std::filesystem::directory_iterator(FileUtils::GetPath(path)))
         {
             if (file.path() != path + "/.DS_Store")
             {
-                Mix_OpenAudio(48000, AUDIO_S16SYS, 1, 1024);
-                Mix_Chunk* sound = Mix_LoadWAV(file.path().string().c_str());
-                loaded_sounds[file.path().filename().stem().stem().string()] = sound;
+                std::string sound_name = file.path().filename().stem().stem().string();
+                
+                if (RendererData::IsHeadless())
+                {
+                    loaded_sounds[sound_name] = nullptr;
+                    continue;
+                }
+                
+                // Clips are converted to the format of the audio device when they're decoded, so it has to be opened first
+                if (!audio_opened)
+                {
+                    Mix_OpenAudio(48000, AUDIO_S16SYS, 1, 1024);
+                    audio_opened = true;
+                }
+                
+                std::string file_path = file.path().string();
+                pending_sounds.emplace_back(sound_name, WorkerPool::Submit([file_path]() {
+                    TRACE_ZONE_NAMED(file_zone, "assets", "DecodeSound");
+                    TRACE_ZONE_ARGS(file_zone, "\"file\":\"" + Tracer::Escape(file_path) + "\"");
+                    
+                    return Mix_LoadWAV(file_path.c_str());
+                }));
             }
         }
     }
+} // StartLoadingSounds()
+
+/**
+ * Waits for the audio started by StartLoadingSounds and adds it to the database
+*/
+void FinishLoadingSounds()
+{
+    TRACE_ZONE("assets", "FinishLoadingSounds");
+    
+    for (auto& [sound_name, decoded_sound] : pending_sounds)
+    {
+        loaded_sounds[sound_name] = decoded_sound.get();
+    }
+    pending_sounds.clear();
     
     Mix_AllocateChannels(50);
+} // FinishLoadingSounds()
+
+/**
+ * Loads all of the audio in the resources/audio directory
+ * When headless only the names are registered and the audio device is never opened
+*/
+void LoadSounds()
+{
+    StartLoadingSounds();
+    FinishLoadingSounds();
 } // LoadSounds();
 
 /**
@@ -129,9 +249,12 @@ Mix_Chunk* GetSound(const std::string& audio_name)
 
 /**
  * Loads all of the fonts in the resources/fonts directory
+ * When headless only the names are registered, fonts are never opened
 */
 void LoadFonts()
 {
+    TRACE_ZONE("assets", "LoadFonts");
+    
     /* Load files from this path */
     const std::string path = "resources/fonts";
     
@@ -142,6 +265,15 @@ void LoadFonts()
         {
             if (file.path() != path + "/.DS_Store")
             {
+                TRACE_ZONE_NAMED(file_zone, "assets", "LoadFont");
+                TRACE_ZONE_ARGS(file_zone, "\"file\":\"" + Tracer::Escape(file.path().filename().string()) + "\"");
+                
+                if (RendererData::IsHeadless())
+                {
+                    loaded_fonts[file.path().filename().stem().stem().string()];
+                    continue;
+                }
+                
                 loaded_fonts[file.path().filename().stem().stem().string()][16] = TTF_OpenFont(file.path().string().c_str(), 16);
             }
         }
@@ -180,10 +312,12 @@ TTF_Font* GetFont(std::string font_name, int font_size)
 // Template Database
 
 /**
- * Loads all of the templates in the resources/actor_templates directory
+ * Starts parsing all of the templates in the resources/actor_templates directory on the worker pool
 */
-void LoadTemplates()
+void StartLoadingTemplates()
 {
+    TRACE_ZONE("assets", "StartLoadingTemplates");
+    
     /* Load files from this path */
     const std::string path = "resources/actor_templates";
     
@@ -194,13 +328,49 @@ void LoadTemplates()
         {
             if (file.path() != path + "/.DS_Store")
             {
-                rapidjson::Document* template_document = new rapidjson::Document;
-                EngineUtils::ReadJsonFile(file.path().string(), *template_document);
-                
-                loaded_templates[file.path().filename().stem().stem().string()] = template_document;
+                std::string file_path = file.path().string();
+                pending_templates.emplace_back(file.path().filename().stem().stem().string(), file_path, WorkerPool::Submit([file_path]() {
+                    TRACE_ZONE_NAMED(file_zone, "assets", "ParseTemplate");
+                    TRACE_ZONE_ARGS(file_zone, "\"file\":\"" + Tracer::Escape(file_path) + "\"");
+                    
+                    // Parse errors are reported by FinishLoadingTemplates, a worker can't exit the process
+                    rapidjson::Document* template_document = new rapidjson::Document;
+                    EngineUtils::ParseJsonFile(file_path, *template_document);
+                    return template_document;
+                }));
             }
         }
     }
+} // StartLoadingTemplates()
+
+/**
+ * Waits for the templates started by StartLoadingTemplates and adds them to the database
+*/
+void FinishLoadingTemplates()
+{
+    TRACE_ZONE("assets", "FinishLoadingTemplates");
+    
+    for (auto& [template_name, file_path, parsed_template] : pending_templates)
+    {
+        rapidjson::Document* template_document = parsed_template.get();
+        if (template_document->HasParseError())
+        {
+            std::cout << "error parsing json at [" << file_path << "]";
+            exit(0);
+        }
+        
+        loaded_templates[template_name] = template_document;
+    }
+    pending_templates.clear();
+} // FinishLoadingTemplates()
+
+/**
+ * Loads all of the templates in the resources/actor_templates directory
+*/
+void LoadTemplates()
+{
+    StartLoadingTemplates();
+    FinishLoadingTemplates();
 } // LoadTemplates()
 
 /**
@@ -220,6 +390,20 @@ rapidjson::Document* GetTemplate(std::string template_name)
     return loaded_templates[template_name];
 } // GetTemplate()
 
+/**
+ * @returns     the names of every loaded template
+*/
+std::vector<std::string> GetTemplateNames()
+{
+    std::vector<std::string> template_names;
+    template_names.reserve(loaded_templates.size());
+    for (const auto& [template_name, actor_template] : loaded_templates)
+    {
+        template_names.push_back(template_name);
+    }
+    return template_names;
+} // GetTemplateNames()
+
 //-------------------------------------------------------
 // Component Type Database
 
@@ -229,6 +413,8 @@ rapidjson::Document* GetTemplate(std::string template_name)
 */
 void LoadComponentTypes()
 {
+    TRACE_ZONE("assets", "LoadComponentTypes");
+    
     /* Load files from this path */
     const std::string path = "resources/component_types";
     
@@ -239,6 +425,9 @@ void LoadComponentTypes()
         {
             if (file.path() != path + "/.DS_Store")
             {
+                TRACE_ZONE_NAMED(file_zone, "assets", "LoadComponentType");
+                TRACE_ZONE_ARGS(file_zone, "\"file\":\"" + Tracer::Escape(file.path().filename().string()) + "\"");
+                
                 std::string type_name = file.path().stem().string();
 
                 sol::load_result script = LuaAPI::GetLuaState()->load_file(file.path().string().c_str());
@@ -250,6 +439,9 @@ void LoadComponentTypes()
                     // Attaches the script to a lua table for easier member access
                     sol::table component_table = (*LuaAPI::GetLuaState())[type_name.c_str()];
                     
+                    // Gives the type its ID, so components of this type can be searched for by ID (see Actors::GetComponentTypeID)
+                    StringTable::Intern(type_name);
+                    
                     // Load the component type into our database
                     loaded_component_types.insert(
                           {
@@ -285,6 +477,30 @@ std::shared_ptr<sol::table> GetComponentType(std::string component_name)
     return loaded_component_types[component_name];
 }
 
+/**
+ * Adds a component type to the database from Lua source instead of a file in resources/component_types
+ * Used by tools that build their scenes in memory (wolverine-bench)
+ *
+ * @param   type_name   the name of the component type, the source must define a global table with this name
+ * @param   source      the Lua source code of the component type
+*/
+void AddComponentType(const std::string& type_name, const std::string& source)
+{
+    sol::load_result script = LuaAPI::GetLuaState()->load(source);
+    if (!script.valid())
+    {
+        std::cout << "problem with lua source " << type_name;
+        exit(0);
+    }
+    
+    // Load the script into the lua state
+    script();
+    
+    sol::table component_table = (*LuaAPI::GetLuaState())[type_name.c_str()];
+    StringTable::Intern(type_name);
+    loaded_component_types[type_name] = std::make_shared<sol::table>(component_table);
+}
+
 //-------------------------------------------------------
 // Scene Path Database
 
@@ -293,6 +509,8 @@ std::shared_ptr<sol::table> GetComponentType(std::string component_name)
 */
 void LoadScenePaths()
 {
+    TRACE_ZONE("assets", "LoadScenePaths");
+    
     /* Load files from this path */
     const std::string path = "resources/scenes";
     
@@ -8,6 +8,9 @@
 
 #include <stdio.h>
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "InputManager.h"
 
 #include "ImageDB.h"
@@ -17,6 +20,13 @@
 #include "SceneDB.h"
 #include "SceneManager.h"
 #include "ComponentManager.h"
+#include "Profiler.h"
+#include "ScriptProfiler.h"
+#include "InputRecorder.h"
+#include "LuaAllocator.h"
+#include "LuaGC.h"
+#include "Tracer.h"
+#include "WorkerPool.h"
 
 #include "Engine.h"
 #include "EngineUtils.h"
@@ -32,6 +42,8 @@ void Game()
 {
     Initialize();
     
+    Uint64 start_counter = SDL_GetPerformanceCounter();
+    
     // 0 means keep looping 1 means stop the loop.
     int loop_status = 0;
     
@@ -40,41 +52,189 @@ void Game()
         loop_status = GameLoop();
     }
     
+    if (EngineData::headless)
+    {
+        double seconds = static_cast<double>(SDL_GetPerformanceCounter() - start_counter) / static_cast<double>(SDL_GetPerformanceFrequency());
+        int frames = std::max(EngineData::frames_run, 1);
+        
+        std::cout << "headless run finished" << std::endl;
+        std::cout << "frames: " << EngineData::frames_run << std::endl;
+        std::cout << "wall time: " << seconds << " s" << std::endl;
+        std::cout << "average frame: " << (seconds * 1000.0) / frames << " ms" << std::endl;
+        std::cout << "frames per second: " << EngineData::frames_run / std::max(seconds, 0.000001) << std::endl;
+        std::cout << "draw requests: " << RendererData::GetHeadlessDrawCount() << std::endl;
+    }
+    
+    InputRecorder::Finish();
+    Tracer::Finish();
+    Profiler::WriteReport();
+    
     return;
 } // Game()
 
 //-------------------------------------------------------
 
+/**
+ * Reads the command line arguments into EngineData
+ * Accepts `--headless`, `--frames N`, `--record path`, `--replay path`, `--seed N`, and `--trace path`
+ *
+ * @param    argc    the number of arguments
+ * @param    argv    the arguments given to main
+ */
+void ParseCommandLine(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        
+        if (arg == "--headless")
+        {
+            EngineData::headless = true;
+        }
+        else if (arg == "--frames" && i + 1 < argc)
+        {
+            EngineData::max_frames = std::max(std::atoi(argv[++i]), 0);
+        }
+        else if (arg == "--record" && i + 1 < argc)
+        {
+            EngineData::record_path = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc)
+        {
+            EngineData::replay_path = argv[++i];
+        }
+        else if (arg == "--seed" && i + 1 < argc)
+        {
+            EngineData::has_random_seed = true;
+            EngineData::random_seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--trace" && i + 1 < argc)
+        {
+            EngineData::trace_path = argv[++i];
+        }
+        else
+        {
+            std::cout << "warning: unknown argument " << arg << std::endl;
+        }
+    }
+} // ParseCommandLine()
+
+//-------------------------------------------------------
+
 /**
  * Called before the first game loop.
  * Prepares the engine for the first loop by initializing other parts of the engine.
 */
 void Initialize()
 {
-    IMG_Init(IMG_INIT_PNG);
-    TTF_Init();
+    Uint64 startup_start = SDL_GetPerformanceCounter();
+    
+    // Started first so that loading shows up in the trace
+    if (EngineData::trace_path != "") { Tracer::Start(EngineData::trace_path); }
+    
+    RendererData::SetHeadless(EngineData::headless);
+    
+    // Seed before anything can ask for a random number so the whole run can be repeated
+    // A replay uses the seed it was recorded with
+    if (EngineData::has_random_seed) { EngineUtils::SeedRandom(EngineData::random_seed); }
+    if (EngineData::replay_path != "")
+    {
+        if (!InputRecorder::StartReplay(EngineData::replay_path)) { exit(0); }
+    }
+    else if (EngineData::record_path != "")
+    {
+        InputRecorder::StartRecording(EngineData::record_path);
+    }
+    
+    {
+        StartupStage stage("WorkerPool::Init");
+        WorkerPool::Init();
+    }
+    
+    {
+        StartupStage stage("IMG_Init/TTF_Init");
+        IMG_Init(IMG_INIT_PNG);
+        TTF_Init();
+    }
+    
+    // Start decoding assets on the worker threads, they are finished further down once the main thread needs them
+    // Everything in between (Lua, the scripts, the renderer) overlaps with the decoding
+    {
+        StartupStage stage("Start asset decoding");
+        StartLoadingTemplates();
+        StartLoadingImages();
+        StartLoadingSounds();
+    }
     
-    LuaAPI::InitLuaState();
-    LuaAPI::ExposeLuaAPI();
-    Input::Init();
-    LoadComponentTypes();
-    LoadScenePaths();
+    {
+        StartupStage stage("Lua state");
+        LuaAPI::InitLuaState();
+        LuaAPI::ExposeLuaAPI();
+        Input::Init();
+    }
+    {
+        StartupStage stage("LoadComponentTypes");
+        LoadComponentTypes();
+    }
+    {
+        StartupStage stage("LoadScenePaths");
+        LoadScenePaths();
+    }
     
     // Load Resources needed for scene initialization
     // Do this here because the initial scene is loaded in CheckConfigFiles.
-    LoadTemplates();
+    {
+        StartupStage stage("FinishLoadingTemplates");
+        FinishLoadingTemplates();
+    }
+    {
+        StartupStage stage("Blueprints and pools");
+        Blueprints::CompileTemplates();
+        Actors::PrewarmPools();
+    }
     
-    if( CheckConfigFiles() != 0 ) {
-        // error with config files
+    {
+        StartupStage stage("Config and initial scene");
+        if( CheckConfigFiles() != 0 ) {
+            // error with config files
+        }
     }
     
-    RendererData::Init(EngineData::game_title);
+    {
+        StartupStage stage("RendererData::Init");
+        RendererData::Init(EngineData::game_title);
+    }
     
     // Load Assets
-    // Do this here because the renderer needs to be initialized before these assets can be loaded.
-    LoadImages();
-    LoadSounds();
-    LoadFonts();
+    // Do this here because the renderer needs to be initialized before textures can be made from the decoded images.
+    {
+        StartupStage stage("FinishLoadingImages");
+        FinishLoadingImages();
+    }
+    {
+        StartupStage stage("FinishLoadingSounds");
+        FinishLoadingSounds();
+    }
+    
+    // Nothing is submitted to the workers after the assets are loaded
+    WorkerPool::Shutdown();
+    
+    {
+        StartupStage stage("LoadFonts");
+        LoadFonts();
+    }
+    
+    // Headless runs go as fast as they can, so every frame is exactly one simulation step
+    if (EngineData::headless) { Time::SetFrameDeltaOverride(Time::GetFixedDeltaTime()); }
+    
+    if (Profiler::IsEnabled() || EngineData::headless)
+    {
+        float startup_ms = static_cast<float>((SDL_GetPerformanceCounter() - startup_start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()));
+        Profiler::PrintStartupReport(startup_ms);
+    }
+    
+    // Start the frame clock last so that loading isn't counted as part of the first frame
+    Time::Init();
 } // Initialize()
 
 //-------------------------------------------------------
@@ -105,6 +265,55 @@ bool CheckGameConfig()
     if(game_config.HasMember("game_title")){
         EngineData::game_title = game_config["game_title"].GetString();
     }
+    if(game_config.HasMember("fixed_updates_per_second")){
+        Time::SetFixedDeltaTime(1.0f / game_config["fixed_updates_per_second"].GetFloat());
+    }
+    if(game_config.HasMember("max_fixed_steps_per_frame")){
+        Time::SetMaxFixedStepsPerFrame(game_config["max_fixed_steps_per_frame"].GetInt());
+    }
+    if(game_config.HasMember("profiler") && game_config["profiler"].GetBool()){
+        int history_frames = 300;
+        if(game_config.HasMember("profiler_history_frames")){
+            history_frames = game_config["profiler_history_frames"].GetInt();
+        }
+        Profiler::Init(history_frames);
+    }
+    if(game_config.HasMember("profiler_font")){
+        Profiler::SetOverlayFont(game_config["profiler_font"].GetString());
+    }
+    if(game_config.HasMember("profiler_report")){
+        Profiler::SetReportPath(game_config["profiler_report"].GetString());
+    }
+    if(game_config.HasMember("script_profiler") && game_config["script_profiler"].GetBool()){
+        int report_frames = 600;
+        int report_top = 10;
+        if(game_config.HasMember("script_profiler_report_frames")){
+            report_frames = game_config["script_profiler_report_frames"].GetInt();
+        }
+        if(game_config.HasMember("script_profiler_top")){
+            report_top = game_config["script_profiler_top"].GetInt();
+        }
+        ScriptProfiler::Init(report_frames, report_top);
+    }
+    if(game_config.HasMember("lua_memory_budget_mb")){
+        LuaAllocator::SetBudget(static_cast<size_t>(game_config["lua_memory_budget_mb"].GetDouble() * 1024.0 * 1024.0));
+    }
+    // The collector is set up before the initial scene loads so the load can end with a full collection
+    {
+        LUA_GC_MODE gc_mode = LUA_GC_MODE_INCREMENTAL;
+        double gc_step_budget_ms = 1.0;
+        int gc_step_kb = 16;
+        if(game_config.HasMember("lua_gc_mode")){
+            gc_mode = LuaGC::GetModeFromName(game_config["lua_gc_mode"].GetString());
+        }
+        if(game_config.HasMember("lua_gc_step_budget_ms")){
+            gc_step_budget_ms = game_config["lua_gc_step_budget_ms"].GetDouble();
+        }
+        if(game_config.HasMember("lua_gc_step_kb")){
+            gc_step_kb = game_config["lua_gc_step_kb"].GetInt();
+        }
+        LuaGC::Init(gc_mode, gc_step_budget_ms, gc_step_kb);
+    }
     if(game_config.HasMember("initial_scene")){
         std::string initial_scene = game_config["initial_scene"].GetString();
         Scene::new_scene_name = initial_scene;
@@ -133,44 +342,128 @@ int GameLoop()
         return 1;
     }
     
+    if (EngineData::max_frames > 0 && EngineData::frames_run >= EngineData::max_frames)
+    {
+        EngineData::quit = true;
+        return 1;
+    }
+    
+    // Replays end once they run out of recorded frames
+    if (InputRecorder::IsReplayFinished(EngineData::frames_run))
+    {
+        EngineData::quit = true;
+        return 1;
+    }
+    
+    ProfileFrameScope profile_frame;
+    LuaAllocator::BeginFrame();
+    ProfileScope frame_scope(PROFILER_PHASE_FRAME);
+    
+    // Measure the last frame and feed it to the simulation clock
+    // Replays use the length the frame had when it was recorded instead
+    InputRecorder::ApplyReplayFrame(EngineData::frames_run);
+    Time::BeginFrame();
+    InputRecorder::RecordFrame(EngineData::frames_run, Time::GetUnscaledDeltaTime());
+    
     // Process all SDL events
-    SDL_Event event;
-    while(SDL_PollEvent(&event))
     {
-        Input::ProcessEvent(event);
-        if (event.type == SDL_QUIT)
+        ProfileScope scope(PROFILER_PHASE_EVENTS);
+        SDL_Event event;
+        while(SDL_PollEvent(&event))
         {
-            EngineData::quit = true;
+            if (event.type == SDL_QUIT)
+            {
+                EngineData::quit = true;
+            }
+            
+            // The player's input is ignored while replaying
+            if (InputRecorder::IsReplaying()) { continue; }
+            
+            InputRecorder::RecordEvent(event);
+            Input::ProcessEvent(event);
         }
+        
+        InputRecorder::ReplayEvents(EngineData::frames_run);
     }
     
-    SDL_RenderClear(RendererData::GetRenderer()); // clear the renderer with the render clear color
+    // Toggles the profiler overlay
+    if (Input::GetKeyDown(SDL_SCANCODE_F3)) { Profiler::ToggleOverlay(); }
     
-    Scene::UpdateActors();
+    if (!EngineData::headless) { SDL_RenderClear(RendererData::GetRenderer()); } // clear the renderer with the render clear color
+    
+    // Fixed rate simulation
+    // Runs as many fixed steps as needed to catch the simulation up with the time that passed since the last frame
+    if (PhysicsWorld::world_initialized) { InitializeCollisions(); }
+    while (Time::ConsumeFixedStep())
+    {
+        {
+            ProfileScope scope(PROFILER_PHASE_FIXED_UPDATE);
+            Scene::FixedUpdateActors();
+        }
+        {
+            ProfileScope scope(PROFILER_PHASE_PHYSICS);
+            PhysicsWorld::AdvanceWorld();
+        }
+    }
+    
+    // Variable rate update, runs exactly once per frame
+    {
+        ProfileScope scope(PROFILER_PHASE_UPDATE_ACTORS);
+        Scene::UpdateActors();
+    }
     
-    // Box2D Physics
-
     if (PhysicsWorld::world_initialized) {
-        InitializeCollisions();
-        PhysicsWorld::AdvanceWorld();
         PhysicsWorld::world->DebugDraw();
     }
+    
+    // Queued before the text is rendered so it shows up this frame
+    Profiler::DrawOverlay();
 
     // RENDER STUFF HERE
-    RendererData::RenderAndClearAllImageRequests();
-    RendererData::RenderAndClearAllTextRequests();
-    RendererData::RenderAndClearAllPixels();
-    RendererData::RenderAndClearAllLines();
-    RendererData::RenderAndClearAllUI();
-    
-    PhysicsWorld::AdvanceWorld();
+    // Nothing is queued when headless, so there is nothing to render or present
+    if (!EngineData::headless)
+    {
+        {
+            ProfileScope scope(PROFILER_PHASE_RENDER_IMAGES);
+            RendererData::RenderAndClearAllImageRequests();
+        }
+        {
+            ProfileScope scope(PROFILER_PHASE_RENDER_TEXT);
+            RendererData::RenderAndClearAllTextRequests();
+        }
+        {
+            ProfileScope scope(PROFILER_PHASE_RENDER_PIXELS);
+            RendererData::RenderAndClearAllPixels();
+        }
+        {
+            ProfileScope scope(PROFILER_PHASE_RENDER_LINES);
+            RendererData::RenderAndClearAllLines();
+        }
+        {
+            ProfileScope scope(PROFILER_PHASE_RENDER_UI);
+            RendererData::RenderAndClearAllUI();
+        }
+        
+        {
+            ProfileScope scope(PROFILER_PHASE_PRESENT);
+            SDL_RenderPresent(RendererData::GetRenderer()); // present the frame into the window
+        }
+    }
     
-    SDL_RenderPresent(RendererData::GetRenderer()); // present the frame into the window
+    // Collect Lua garbage in the time after the frame has been shown, instead of whenever a script happens to allocate
+    {
+        ProfileScope scope(PROFILER_PHASE_LUA_GC);
+        LuaGC::Step();
+    }
     
     Input::LateUpdate();
     
     // Load the new scene if asked for
     if (Scene::load_new_scene) {Scene::LoadNewScene();}
     
+    ScriptProfiler::EndFrame();
+    
+    EngineData::frames_run++;
+    
     return 0;
 } // GameLoop()
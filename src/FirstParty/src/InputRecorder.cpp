@@ -0,0 +1,251 @@
+//
+//  InputRecorder.cpp
+//  wolverine_engine
+//
+//  Records the input events of a session to a file and plays them back frame for frame
+//
+
+#include <stdio.h>
+
+#include <cstring>
+#include <iostream>
+
+#include "InputRecorder.h"
+#include "InputManager.h"
+#include "TimeManager.h"
+#include "EngineUtils.h"
+
+static const char recording_magic[4] = { 'W', 'V', 'I', 'R' }; // The first four bytes of every recording
+static const Uint32 recording_version = 1; // Bump whenever the layout of the records changes
+
+/**
+ * Writes a float as its little endian bit pattern
+ *
+ * @param    file     the file to write to
+ * @param    value    the float to write
+ */
+static void WriteFloat(SDL_RWops* file, const float value)
+{
+    Uint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    SDL_WriteLE32(file, bits);
+}
+
+/**
+ * Reads a float written by WriteFloat
+ *
+ * @param    file    the file to read from
+ * @returns          the float that was read
+ */
+static float ReadFloat(SDL_RWops* file)
+{
+    Uint32 bits = SDL_ReadLE32(file);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * Starts writing every input event to a file.
+ * The random seed is stored in the file so the replay makes the same random numbers.
+ *
+ * @param    path    the file to write the recording to
+ * @returns          true if the file could be opened
+ */
+bool InputRecorder::StartRecording(const std::string& path)
+{
+    record_file = SDL_RWFromFile(path.c_str(), "wb");
+    if (record_file == nullptr)
+    {
+        std::cout << "error: could not open " << path << " to record input" << std::endl;
+        return false;
+    }
+
+    SDL_RWwrite(record_file, recording_magic, 1, sizeof(recording_magic));
+    SDL_WriteLE32(record_file, recording_version);
+    SDL_WriteLE32(record_file, EngineUtils::GetRandomSeed());
+
+    return true;
+}
+
+/**
+ * Loads a recording and starts feeding it to Input instead of the live events.
+ * Seeds the random number generator with the seed the recording was made with.
+ *
+ * @param    path    the recording to play back
+ * @returns          true if the recording could be read
+ */
+bool InputRecorder::StartReplay(const std::string& path)
+{
+    SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+    if (file == nullptr)
+    {
+        std::cout << "error: could not open input recording " << path << std::endl;
+        return false;
+    }
+
+    char magic[4] = {};
+    SDL_RWread(file, magic, 1, sizeof(magic));
+    Uint32 version = SDL_ReadLE32(file);
+    if (std::memcmp(magic, recording_magic, sizeof(magic)) != 0 || version != recording_version)
+    {
+        std::cout << "error: " << path << " is not a compatible input recording" << std::endl;
+        SDL_RWclose(file);
+        return false;
+    }
+
+    EngineUtils::SeedRandom(SDL_ReadLE32(file));
+
+    replay_frames.clear();
+
+    Uint8 tag;
+    while (SDL_RWread(file, &tag, 1, 1) == 1)
+    {
+        if (tag == INPUT_RECORD_FRAME)
+        {
+            // Frames are written in order, the index is only there to catch a corrupt file
+            Uint32 frame = SDL_ReadLE32(file);
+            if (frame != replay_frames.size())
+            {
+                std::cout << "error: input recording " << path << " skips from frame " << replay_frames.size() << " to " << frame << std::endl;
+                break;
+            }
+
+            RecordedFrame new_frame;
+            new_frame.delta_time = ReadFloat(file);
+            replay_frames.push_back(new_frame);
+            continue;
+        }
+
+        // Every other record is an event that belongs to the last frame
+        if (replay_frames.empty()) { break; }
+
+        SDL_Event e;
+        SDL_zero(e);
+        switch (tag)
+        {
+            case INPUT_RECORD_KEY_DOWN:
+            case INPUT_RECORD_KEY_UP:
+                e.type = (tag == INPUT_RECORD_KEY_DOWN) ? SDL_KEYDOWN : SDL_KEYUP;
+                e.key.keysym.scancode = static_cast<SDL_Scancode>(SDL_ReadLE16(file));
+                break;
+            case INPUT_RECORD_MOUSE_DOWN:
+            case INPUT_RECORD_MOUSE_UP:
+                e.type = (tag == INPUT_RECORD_MOUSE_DOWN) ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+                e.button.button = SDL_ReadU8(file);
+                break;
+            case INPUT_RECORD_MOUSE_WHEEL:
+                e.type = SDL_MOUSEWHEEL;
+                e.wheel.preciseY = ReadFloat(file);
+                break;
+            case INPUT_RECORD_MOUSE_MOTION:
+                e.type = SDL_MOUSEMOTION;
+                e.motion.x = static_cast<Sint32>(SDL_ReadLE32(file));
+                e.motion.y = static_cast<Sint32>(SDL_ReadLE32(file));
+                break;
+            default:
+                std::cout << "error: unknown record in input recording " << path << std::endl;
+                SDL_RWclose(file);
+                return false;
+        }
+
+        replay_frames.back().events.push_back(e);
+    }
+
+    SDL_RWclose(file);
+
+    replaying = true;
+    std::cout << "replaying " << replay_frames.size() << " frames from " << path << std::endl;
+    return true;
+}
+
+/**
+ * Closes the recording file, call before the game exits
+ */
+void InputRecorder::Finish()
+{
+    if (record_file == nullptr) { return; }
+
+    SDL_RWclose(record_file);
+    record_file = nullptr;
+}
+
+/**
+ * While replaying, makes the frame the same length as it was when it was recorded.
+ * Call right before Time::BeginFrame.
+ *
+ * @param    frame    the index of the frame that is starting
+ */
+void InputRecorder::ApplyReplayFrame(const int frame)
+{
+    if (!replaying || frame >= static_cast<int>(replay_frames.size())) { return; }
+
+    Time::SetFrameDeltaOverride(replay_frames[frame].delta_time);
+}
+
+/**
+ * While recording, starts a new frame in the recording.
+ * Call right after Time::BeginFrame.
+ *
+ * @param    frame         the index of the frame that is starting
+ * @param    delta_time    the unscaled length of the frame in seconds
+ */
+void InputRecorder::RecordFrame(const int frame, const float delta_time)
+{
+    if (record_file == nullptr) { return; }
+
+    SDL_WriteU8(record_file, INPUT_RECORD_FRAME);
+    SDL_WriteLE32(record_file, static_cast<Uint32>(frame));
+    WriteFloat(record_file, delta_time);
+}
+
+/**
+ * While recording, adds an event to the current frame if it is one that Input uses
+ *
+ * @param    e    the event taken from the SDL event queue
+ */
+void InputRecorder::RecordEvent(const SDL_Event& e)
+{
+    if (record_file == nullptr) { return; }
+
+    switch (e.type)
+    {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            SDL_WriteU8(record_file, (e.type == SDL_KEYDOWN) ? INPUT_RECORD_KEY_DOWN : INPUT_RECORD_KEY_UP);
+            SDL_WriteLE16(record_file, static_cast<Uint16>(e.key.keysym.scancode));
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            SDL_WriteU8(record_file, (e.type == SDL_MOUSEBUTTONDOWN) ? INPUT_RECORD_MOUSE_DOWN : INPUT_RECORD_MOUSE_UP);
+            SDL_WriteU8(record_file, e.button.button);
+            break;
+        case SDL_MOUSEWHEEL:
+            SDL_WriteU8(record_file, INPUT_RECORD_MOUSE_WHEEL);
+            WriteFloat(record_file, e.wheel.preciseY);
+            break;
+        case SDL_MOUSEMOTION:
+            SDL_WriteU8(record_file, INPUT_RECORD_MOUSE_MOTION);
+            SDL_WriteLE32(record_file, static_cast<Uint32>(e.motion.x));
+            SDL_WriteLE32(record_file, static_cast<Uint32>(e.motion.y));
+            break;
+        default:
+            // Input ignores everything else, so there is no need to store it
+            break;
+    }
+}
+
+/**
+ * While replaying, sends all of the events recorded for this frame to Input
+ *
+ * @param    frame    the index of the current frame
+ */
+void InputRecorder::ReplayEvents(const int frame)
+{
+    if (!replaying || frame >= static_cast<int>(replay_frames.size())) { return; }
+
+    for (const SDL_Event& e : replay_frames[frame].events)
+    {
+        Input::ProcessEvent(e);
+    }
+}
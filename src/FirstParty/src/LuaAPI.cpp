@@ -6,6 +6,10 @@
 //  Exposes API functions to lua
 
 #include "LuaAPI.h"
+#include "Coroutines.h"
+#include "Engine.h"
+#include "Profiler.h"
+#include "ScriptProfiler.h"
 
 /**
 * Exposes all of the API functions to Sol to be used in Lua
@@ -16,6 +20,10 @@ void LuaAPI::ExposeLuaAPI()
 	(*GetLuaState())["Debug"] = GetLuaState()->create_table();
 	(*GetLuaState())["Debug"]["Log"] = &LuaAPI::Log;
 	(*GetLuaState())["Debug"]["LogError"] = &LuaAPI::LogError;
+	(*GetLuaState())["Debug"]["SetProfilerOverlay"] = &Profiler::SetOverlayVisible;
+	(*GetLuaState())["Debug"]["GetProfile"] = &ScriptProfiler::GetProfile;
+	(*GetLuaState())["Debug"]["ResetProfile"] = &ScriptProfiler::Reset;
+	(*GetLuaState())["Debug"]["GetMemoryStats"] = &LuaAllocator::GetStats;
 
 	// Application Namespace
 	(*GetLuaState())["Application"] = GetLuaState()->create_table();
@@ -25,6 +33,15 @@ void LuaAPI::ExposeLuaAPI()
 	(*GetLuaState())["Application"]["OpenURL"] = &LuaAPI::OpenURL;
     (*GetLuaState())["Application"]["RandomNumber"] = &EngineUtils::RandomNumber;
 
+	// Time Namespace
+	(*GetLuaState())["Time"] = GetLuaState()->create_table();
+	(*GetLuaState())["Time"]["DeltaTime"] = &Time::GetDeltaTime;
+	(*GetLuaState())["Time"]["UnscaledDeltaTime"] = &Time::GetUnscaledDeltaTime;
+	(*GetLuaState())["Time"]["FixedDeltaTime"] = &Time::GetFixedDeltaTime;
+	(*GetLuaState())["Time"]["GetTimeScale"] = &Time::GetTimeScale;
+	(*GetLuaState())["Time"]["SetTimeScale"] = &Time::SetTimeScale;
+	(*GetLuaState())["Time"]["GetTime"] = &Time::GetTime;
+
 	// Input Namespace
 	(*GetLuaState())["Input"] = GetLuaState()->create_table();
 	(*GetLuaState())["Input"]["GetKey"] = &Input::GetKey_S;
@@ -48,7 +65,11 @@ void LuaAPI::ExposeLuaAPI()
     (*GetLuaState())["Scene"]["FindActorByID"] = &Scene::FindActorByID;
     (*GetLuaState())["Scene"]["FindActorWithName"] = &Scene::FindActorWithName;
     (*GetLuaState())["Scene"]["FindAllActorsWithName"] = &Scene::FindAllActorsWithName;
+    (*GetLuaState())["Scene"]["GetNameID"] = &Scene::GetNameID;
+    (*GetLuaState())["Scene"]["FindActorWithNameID"] = &Scene::FindActorWithNameID;
+    (*GetLuaState())["Scene"]["FindAllActorsWithNameID"] = &Scene::FindAllActorsWithNameID;
     (*GetLuaState())["Scene"]["Load"] = &Scene::ChangeScene;
+    (*GetLuaState())["Scene"]["DestroyAll"] = &Scene::DestroyAll;
 
 	// Audio Namespace
 	(*GetLuaState())["Audio"] = GetLuaState()->create_table();
@@ -116,12 +137,7 @@ void LuaAPI::ExposeLuaAPI()
 	);
 	
 	// Rigidbody Class
-	LuaAPI::GetLuaState()->new_usertype<Rigidbody>("Rigidbody",
-		"enabled", &Rigidbody::enabled,
-		"key", &Rigidbody::key,
-		"type", &Rigidbody::type,
-		"actor", &Rigidbody::actor,
-        "REMOVED_FROM_ACTOR", &Rigidbody::REMOVED_FROM_ACTOR,
+	ComponentManager::RegisterNativeComponent<Rigidbody>("Rigidbody",
 		"x", &Rigidbody::x,
 		"y", &Rigidbody::y,
 		"body_type", &Rigidbody::body_type,
@@ -144,8 +160,8 @@ void LuaAPI::ExposeLuaAPI()
 		"bounciness", &Rigidbody::bounciness,
 		"GetPosition", &Rigidbody::GetPosition,
 		"GetRotation", &Rigidbody::GetRotation,
-		"OnStart", &Rigidbody::OnStart,
-        "OnDestroy", &Rigidbody::OnDestroy,
+		"GetInterpolatedPosition", &Rigidbody::GetInterpolatedPosition,
+		"GetInterpolatedRotation", &Rigidbody::GetInterpolatedRotation,
 		"AddForce", &Rigidbody::AddForce,
 		"SetVelocity", &Rigidbody::SetVelocity,
 		"SetPosition", &Rigidbody::SetPosition,
@@ -162,14 +178,9 @@ void LuaAPI::ExposeLuaAPI()
 	);
     
     // Particle System class
-    LuaAPI::GetLuaState()->new_usertype<ParticleSystem>("ParticleSystem",
+    ComponentManager::RegisterNativeComponent<ParticleSystem>("ParticleSystem",
         // Member variables
         "MAX_NUM_PARTICLES", &ParticleSystem::MAX_NUM_PARTICLES,
-        "type", &ParticleSystem::type,
-        "key", &ParticleSystem::key,
-        "actor", &ParticleSystem::actor,
-        "REMOVED_FROM_ACTOR", &ParticleSystem::REMOVED_FROM_ACTOR,
-        "enabled", &ParticleSystem::enabled,
         "emitting", &ParticleSystem::emitting,
         "duration", &ParticleSystem::duration,
         "loop", &ParticleSystem::loop,
@@ -211,19 +222,11 @@ void LuaAPI::ExposeLuaAPI()
         
         // Member functions
         "StartEmitting", &ParticleSystem::StartEmitting,
-        "StopEmitting", &ParticleSystem::StopEmitting,
-        "OnStart", &ParticleSystem::OnStart,
-        "OnUpdate", &ParticleSystem::OnUpdate,
-        "OnDestroy", &ParticleSystem::OnDestroy
+        "StopEmitting", &ParticleSystem::StopEmitting
     );
 
     // SpriteRenderer Class
-    LuaAPI::GetLuaState()->new_usertype<SpriteRenderer>("SpriteRenderer",
-        "enabled", &SpriteRenderer::enabled,
-        "key", &SpriteRenderer::key,
-        "type", &SpriteRenderer::type,
-        "actor", &SpriteRenderer::actor,
-        "REMOVED_FROM_ACTOR", &SpriteRenderer::REMOVED_FROM_ACTOR,
+    ComponentManager::RegisterNativeComponent<SpriteRenderer>("SpriteRenderer",
         "sprite", &SpriteRenderer::sprite,
         "x", &SpriteRenderer::x,
         "y", &SpriteRenderer::y,
@@ -233,10 +236,7 @@ void LuaAPI::ExposeLuaAPI()
         "pivot_x", &SpriteRenderer::pivot_x,
         "pivot_y", &SpriteRenderer::pivot_y,
         "rotation", &SpriteRenderer::rotation,
-        "sorting_order", &SpriteRenderer::sorting_order,
-        "OnUpdate", &SpriteRenderer::OnUpdate,
-        "OnStart", &SpriteRenderer::OnStart,
-        "OnDestroy", &SpriteRenderer::OnDestroy
+        "sorting_order", &SpriteRenderer::sorting_order
     );
 
     
@@ -248,12 +248,31 @@ void LuaAPI::ExposeLuaAPI()
     (*GetLuaState())["Actors"] = GetLuaState()->create_table();
     (*GetLuaState())["Actors"]["GetName"] = &Actors::GetName;
     (*GetLuaState())["Actors"]["GetActorEnabled"] = &Actors::GetActorEnabled;
+    (*GetLuaState())["Actors"]["SetActorEnabled"] = &Actors::SetActorEnabled;
+    (*GetLuaState())["Actors"]["SetComponentEnabled"] = &Actors::SetComponentEnabled;
+    (*GetLuaState())["Actors"]["SetUpdateGroupEnabled"] = &Actors::SetUpdateGroupEnabled;
     (*GetLuaState())["Actors"]["RemoveComponent"] = &Actors::RemoveComponentFromActor;
     (*GetLuaState())["Actors"]["GetComponentByType"] = &Actors::GetComponentByType;
     (*GetLuaState())["Actors"]["GetComponentsByType"] = &Actors::GetComponentsByType;
     (*GetLuaState())["Actors"]["GetComponentByKey"] = &Actors::GetComponentByKey;
+    (*GetLuaState())["Actors"]["GetComponentTypeID"] = &Actors::GetComponentTypeID;
+    (*GetLuaState())["Actors"]["GetComponentByTypeID"] = &Actors::GetComponentByTypeID;
     (*GetLuaState())["Actors"]["Instantiate"] = &Scene::Instantiate;
+    (*GetLuaState())["Actors"]["InstantiateMany"] = &Scene::InstantiateMany;
     (*GetLuaState())["Actors"]["Destroy"] = &Scene::Destroy;
+    (*GetLuaState())["Actors"]["DestroyMany"] = &Scene::DestroyMany;
+    
+    // The "Engine" namespace
+    (*GetLuaState())["Engine"] = GetLuaState()->create_table();
+    (*GetLuaState())["Engine"]["StartCoroutine"] = &Coroutines::StartCoroutine;
+    (*GetLuaState())["Engine"]["StopCoroutine"] = &Coroutines::StopCoroutine;
+    (*GetLuaState())["Engine"]["RaiseEvent"] = &Coroutines::RaiseEvent;
+    (*GetLuaState())["Engine"]["GetCoroutineCount"] = &Coroutines::GetCount;
+    
+    // Waits for coroutines, each one yields what it waits for and the coroutine is resumed by Coroutines::Update once it happens
+    (*GetLuaState())["WaitFrames"] = sol::yielding([](int num_frames) { return std::make_tuple(static_cast<int>(COROUTINE_WAIT_FRAMES), num_frames); });
+    (*GetLuaState())["WaitSeconds"] = sol::yielding([](double seconds) { return std::make_tuple(static_cast<int>(COROUTINE_WAIT_SECONDS), seconds); });
+    (*GetLuaState())["WaitUntilEvent"] = sol::yielding([](const std::string& event_name) { return std::make_tuple(static_cast<int>(COROUTINE_WAIT_EVENT), event_name); });
 }
 
 
@@ -269,7 +288,8 @@ void deny_write() { std::cout << "error: attempt to modify a dead lua table" <<
 */
 void LuaAPI::DeleteLuaTable(std::shared_ptr<sol::table> table)
 {
-    if (ComponentManager::IsComponentTypeNative((*table)["type"]))
+    // Native components are userdata instead of tables
+    if (table->get_type() == sol::type::userdata)
     {
         // TODO: Find a way to delete native components FROM LUA STATE without memory shenanigans
         // sol::objects cannot be cleared and locked the same way that tables can. So native components must be treated differently here
@@ -278,6 +298,9 @@ void LuaAPI::DeleteLuaTable(std::shared_ptr<sol::table> table)
     {
         (*table).clear();
         
+        // Keep the flag the engine loops check so a dead component still in one of their lists gets skipped
+        (*table).raw_set("REMOVED_FROM_ACTOR", true);
+        
         // Create the new read-only table
         sol::table dead_table = LuaAPI::GetLuaState()->create_table();
         dead_table[sol::meta_function::new_index] = deny_write;
@@ -309,12 +332,12 @@ void LuaAPI::LogError(const std::string& message)
 }
 
 /**
-* Quits the application.
+* Quits the application at the end of the current frame.
 * Used in the Lua API Application namespace
 */
 void LuaAPI::Quit()
 {
-	exit(0);
+	EngineData::quit = true;
 }
 
 /**
@@ -0,0 +1,173 @@
+//
+//  LuaAllocator.cpp
+//  wolverine_engine
+//
+//  The allocator given to the Lua state, keeps track of how much memory the scripts are using and can cap it
+//
+
+#include <stdlib.h>
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "LuaAllocator.h"
+#include "LuaAPI.h"
+
+static const char* size_class_names[LUA_SIZE_CLASS_COUNT] = {
+    "<=16",
+    "<=32",
+    "<=64",
+    "<=128",
+    "<=256",
+    "<=512",
+    "<=1K",
+    "<=2K",
+    "<=4K",
+    ">4K"
+};
+
+/**
+ * The lua_Alloc function given to the Lua state
+ * Follows the lua_Alloc contract: frees when nsize is 0, and never fails when a block shrinks
+ *
+ * @param    ud       unused
+ * @param    ptr      the block being resized or freed, null for a new block
+ * @param    osize    the old size of the block, or the type of object being made when ptr is null
+ * @param    nsize    the new size of the block
+ * @returns           the resized block, or null when it was freed or couldn't be allocated
+ */
+void* LuaAllocator::Allocate(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+    (void)ud;
+
+    // When ptr is null osize is the type of the object, not a size
+    const size_t old_size = (ptr == nullptr) ? 0 : osize;
+
+    if (nsize == 0)
+    {
+        if (ptr != nullptr)
+        {
+            free(ptr);
+            live_bytes -= old_size;
+            total_frees++;
+        }
+        return nullptr;
+    }
+
+    // Lua expects shrinking to always work, so only growth is checked against the budget
+    // Failing here makes Lua run a full collection and try again before it raises an error
+    if (nsize > old_size && budget_bytes != 0 && live_bytes - old_size + nsize > budget_bytes)
+    {
+        if (failed_allocations == 0)
+        {
+            std::cout << "warning: the Lua heap hit its budget of " << budget_bytes << " bytes" << std::endl;
+        }
+        failed_allocations++;
+        return nullptr;
+    }
+
+    void* new_ptr = realloc(ptr, nsize);
+    if (new_ptr == nullptr) { return nullptr; }
+
+    live_bytes = live_bytes - old_size + nsize;
+    if (live_bytes > peak_bytes) { peak_bytes = live_bytes; }
+
+    if (nsize > old_size)
+    {
+        total_allocations++;
+        frame_allocations++;
+        frame_allocated_bytes += nsize - old_size;
+        size_class_counts[GetSizeClass(nsize)]++;
+    }
+
+    return new_ptr;
+}
+
+/**
+ * Moves this frame's allocation counts into the last frame's, call once at the start of every frame
+ */
+void LuaAllocator::BeginFrame()
+{
+    last_frame_allocations = frame_allocations;
+    last_frame_allocated_bytes = frame_allocated_bytes;
+    frame_allocations = 0;
+    frame_allocated_bytes = 0;
+}
+
+/**
+ * Sets the most memory the Lua state is allowed to use
+ * Allocations that would go over the budget fail and Lua raises a "not enough memory" error in the script that made them
+ *
+ * @param    bytes    the budget in bytes, 0 removes the budget
+ */
+void LuaAllocator::SetBudget(const size_t bytes)
+{
+    budget_bytes = bytes;
+    if (budget_bytes != 0 && live_bytes > budget_bytes)
+    {
+        std::cout << "warning: the Lua heap is already using " << live_bytes << " bytes, more than its budget of " << budget_bytes << std::endl;
+    }
+}
+
+/**
+ * @returns    a table with the current memory stats, given to Lua as Debug.GetMemoryStats
+ */
+sol::table LuaAllocator::GetStats()
+{
+    sol::table stats = LuaAPI::GetLuaState()->create_table();
+    stats["live_bytes"] = live_bytes;
+    stats["peak_bytes"] = peak_bytes;
+    stats["budget_bytes"] = budget_bytes;
+    stats["allocations"] = total_allocations;
+    stats["frees"] = total_frees;
+    stats["failed_allocations"] = failed_allocations;
+    stats["frame_allocations"] = last_frame_allocations;
+    stats["frame_allocated_bytes"] = last_frame_allocated_bytes;
+
+    sol::table histogram = LuaAPI::GetLuaState()->create_table();
+    for (int size_class = 0; size_class < LUA_SIZE_CLASS_COUNT; size_class++)
+    {
+        histogram[size_class_names[size_class]] = size_class_counts[size_class];
+    }
+    stats["size_classes"] = histogram;
+
+    return stats;
+}
+
+/**
+ * @returns    a one line summary of the Lua heap for the profiler overlay
+ */
+std::string LuaAllocator::GetSummary()
+{
+    std::stringstream summary;
+    summary << std::fixed << std::setprecision(1);
+    summary << "lua heap " << live_bytes / 1024.0 << " KB (peak " << peak_bytes / 1024.0 << " KB";
+    if (budget_bytes != 0) { summary << ", budget " << budget_bytes / 1024.0 << " KB"; }
+    summary << "), " << last_frame_allocations << " allocs/frame";
+    return summary.str();
+}
+
+/**
+ * @param    size_class    the size class to get the name of
+ * @returns                the name of the size class, ex: "<=64"
+ */
+const char* LuaAllocator::GetSizeClassName(const LUA_SIZE_CLASS size_class)
+{
+    return size_class_names[size_class];
+}
+
+/**
+ * @param    size    the size of an allocation in bytes
+ * @returns          the size class the allocation is counted in
+ */
+LUA_SIZE_CLASS LuaAllocator::GetSizeClass(const size_t size)
+{
+    size_t class_limit = 16;
+    for (int size_class = 0; size_class < LUA_SIZE_CLASS_LARGE; size_class++)
+    {
+        if (size <= class_limit) { return static_cast<LUA_SIZE_CLASS>(size_class); }
+        class_limit *= 2;
+    }
+    return LUA_SIZE_CLASS_LARGE;
+}
@@ -0,0 +1,124 @@
+//
+//  LuaGC.cpp
+//  wolverine_engine
+//
+//  Takes control of Lua's garbage collector so collection happens after the frame is presented instead of in the middle of a script
+//
+
+#include <algorithm>
+#include <iostream>
+
+#include "LuaGC.h"
+#include "LuaAPI.h"
+#include "LuaAllocator.h"
+#include "Tracer.h"
+
+/**
+ * Sets up the collector, called once the Lua state exists and the config has been read
+ *
+ * @param    new_mode              who runs the collector and how
+ * @param    new_step_budget_ms    the most time spent collecting after each frame
+ * @param    new_step_kb           how much work each slice does
+ */
+void LuaGC::Init(const LUA_GC_MODE new_mode, const double new_step_budget_ms, const int new_step_kb)
+{
+    mode = new_mode;
+    step_budget_ms = std::max(new_step_budget_ms, 0.0);
+    step_kb = std::max(new_step_kb, 1);
+    step_budget_ticks = static_cast<Uint64>(step_budget_ms * static_cast<double>(SDL_GetPerformanceFrequency()) / 1000.0);
+
+    lua_State* L = LuaAPI::GetLuaState()->lua_state();
+    switch (mode)
+    {
+        case LUA_GC_MODE_AUTOMATIC:
+            lua_gc(L, LUA_GCINC, 0, 0, 0);
+            lua_gc(L, LUA_GCRESTART);
+            break;
+        case LUA_GC_MODE_INCREMENTAL:
+            lua_gc(L, LUA_GCINC, 0, 0, 0);
+            lua_gc(L, LUA_GCSTOP);
+            break;
+        case LUA_GC_MODE_GENERATIONAL:
+            lua_gc(L, LUA_GCGEN, 0, 0);
+            lua_gc(L, LUA_GCSTOP);
+            break;
+    }
+
+    // Stopping the collector only stops the automatic steps
+    // If an allocation fails (ex: the heap budget is hit) Lua still runs an emergency full collection
+    bytes_after_collection = LuaAllocator::GetLiveBytes();
+    in_cycle = false;
+}
+
+/**
+ * Runs collection for up to the step budget, call once per frame after the frame is presented
+ */
+void LuaGC::Step()
+{
+    if (mode == LUA_GC_MODE_AUTOMATIC) { return; }
+
+    lua_State* L = LuaAPI::GetLuaState()->lua_state();
+    size_t heap_bytes = LuaAllocator::GetLiveBytes();
+
+    if (mode == LUA_GC_MODE_GENERATIONAL)
+    {
+        // A minor collection can't be split up, so the budget only decides whether there is time for one
+        if (step_budget_ms <= 0.0 || heap_bytes < bytes_after_collection * minor_multiplier) { return; }
+
+        TRACE_ZONE("lua", "LuaGC::MinorCollection");
+        lua_gc(L, LUA_GCSTEP, 0);
+        bytes_after_collection = LuaAllocator::GetLiveBytes();
+        return;
+    }
+
+    if (!in_cycle)
+    {
+        if (heap_bytes < bytes_after_collection * pause_multiplier) { return; }
+        in_cycle = true;
+    }
+
+    TRACE_ZONE("lua", "LuaGC::Step");
+
+    // If the scripts allocate faster than the budget lets the cycle collect, stop waiting for idle time so memory can't grow forever
+    bool catching_up = heap_bytes > bytes_after_collection * catch_up_multiplier;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    while (catching_up || SDL_GetPerformanceCounter() - start < step_budget_ticks)
+    {
+        // Returns 1 once the step finishes the cycle
+        if (lua_gc(L, LUA_GCSTEP, step_kb) == 1)
+        {
+            in_cycle = false;
+            bytes_after_collection = LuaAllocator::GetLiveBytes();
+            break;
+        }
+    }
+}
+
+/**
+ * Finishes the current cycle and collects everything that can be collected
+ * Used while a scene loads, where a hitch isn't noticed
+ */
+void LuaGC::FullCollect()
+{
+    TRACE_ZONE("lua", "LuaGC::FullCollect");
+
+    lua_gc(LuaAPI::GetLuaState()->lua_state(), LUA_GCCOLLECT);
+    bytes_after_collection = LuaAllocator::GetLiveBytes();
+    in_cycle = false;
+}
+
+/**
+ * @param    name    the name of a mode as written in game.config ("automatic", "incremental", or "generational")
+ * @returns          the mode, or LUA_GC_MODE_INCREMENTAL if the name isn't known
+ */
+LUA_GC_MODE LuaGC::GetModeFromName(const std::string& name)
+{
+    if (name == "automatic") { return LUA_GC_MODE_AUTOMATIC; }
+    if (name == "generational") { return LUA_GC_MODE_GENERATIONAL; }
+    if (name != "incremental")
+    {
+        std::cout << "warning: unknown lua_gc_mode " << name << ", using incremental" << std::endl;
+    }
+    return LUA_GC_MODE_INCREMENTAL;
+}
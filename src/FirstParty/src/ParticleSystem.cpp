@@ -15,7 +15,8 @@
 void ParticleSystem::StartEmitting()
 {
     emitting = true;
-    framesActive = 0.0f;
+    time_active = 0.0f;
+    emission_accumulator = 0.0f;
 }
 
 void ParticleSystem::StopEmitting()
@@ -61,15 +62,15 @@ void ParticleSystem::CreateParticle()
     particles.push(newParticle);
 }
 
-void ParticleSystem::UpdateParticle(Particle* particle)
+void ParticleSystem::UpdateParticle(Particle* particle, float delta_time)
 {
     // Update particles according to a pattern (also update particle's hitbox size to match if size changes)
     
     // Update color
     if (change_color)
     {
-        // The change in color per frame
-        std::vector<float> delta_color = GetDeltaColor(particle);
+        // The change in color this frame
+        std::vector<float> delta_color = GetDeltaColor(particle, delta_time);
         
         particle->color[0] += delta_color[0];
         if (particle->color[0] >= 255.0f) {particle->color[0] = 255.0f;}
@@ -98,7 +99,7 @@ void ParticleSystem::UpdateParticle(Particle* particle)
         {
             case 'l':
                 // Linear pattern
-                delta_size = size_change_per_second / 60;
+                delta_size = size_change_per_second * delta_time;
                 particle->size += delta_size;
                 break;
                 
@@ -164,7 +165,7 @@ void ParticleSystem::UpdateParticle(Particle* particle)
     }
 }
 
-std::vector<float> ParticleSystem::GetDeltaColor(Particle* particle)
+std::vector<float> ParticleSystem::GetDeltaColor(Particle* particle, float delta_time)
 {
     float percent_of_lifetime = particle->age / particle_lifetime;
     
@@ -197,7 +198,7 @@ std::vector<float> ParticleSystem::GetDeltaColor(Particle* particle)
     std::vector<float> delta_color;
     for (int i = 0; i < 4; i++)
     {
-        delta_color.push_back((colors[particle->future_color_index][i] - colors[particle->former_color_index][i]) / (60 * transition_time));
+        delta_color.push_back((colors[particle->future_color_index][i] - colors[particle->former_color_index][i]) * (delta_time / transition_time));
     }
     return delta_color;
 }
@@ -245,7 +246,8 @@ void ParticleSystem::RenderParticle(Particle* particle)
     int particleWidth = 0;
     int particleHeight = 0;
     SDL_QueryTexture(GetImage(image), NULL, NULL, &particleWidth, &particleHeight);
-    float particleScale = particle->size / (particleWidth / RendererData::PIXELS_PER_METER);
+    float particleScale = 1.0f;
+    if (particleWidth > 0) { particleScale = particle->size / (particleWidth / RendererData::PIXELS_PER_METER); } // No texture when headless
     
     RendererData::DrawImageEx(image, position.x, position.y, rotation, particleScale, particleScale, 0.5f, 0.5f, particle->color[0], particle->color[1], particle->color[2], particle->color[3], sorting_order);
 }
@@ -345,25 +347,18 @@ void ParticleSystem::OnStart()
 
 void ParticleSystem::OnUpdate()
 {
+    float delta_time = Time::GetDeltaTime();
+    
     /* Emission Phase */
-    if (emitting && num_particles < MAX_NUM_PARTICLES)
+    if (emitting)
     {
-        // Emission rate is impercise with larger rates,
-        // But the larger rates should result in a more accurate aproximation
-        if (emission_rate > 60)
-        {
-            int num_particles_to_spawn = std::ceil(EngineUtils::RandomNumber(0, (emission_rate / 60.0f) * 2u, 100));
-            //std::cout << num_particles_to_spawn << std::endl;
-            if (num_particles + num_particles_to_spawn < MAX_NUM_PARTICLES)
-            {
-                for (int i = 0; i < num_particles_to_spawn; i++)
-                {
-                    CreateParticle();
-                }
-            }
-        }
-        // Emission rate is exact when less than 60, this is because each second is exactly 60 frames long.
-        else if (framesActive % (60 / emission_rate) == 0)
+        // Spawns however many particles the emission rate says are owed for the time that has passed.
+        // Leftover fractions of a particle carry over so the rate is exact at any frame rate.
+        emission_accumulator += emission_rate * delta_time;
+        int num_particles_to_spawn = static_cast<int>(emission_accumulator);
+        emission_accumulator -= num_particles_to_spawn;
+        
+        for (int i = 0; i < num_particles_to_spawn && num_particles < MAX_NUM_PARTICLES; i++)
         {
             CreateParticle();
         }
@@ -379,10 +374,10 @@ void ParticleSystem::OnUpdate()
         Particle* particle = particles.front();
         particles.pop();
         
-        UpdateParticle(particle);
+        UpdateParticle(particle, delta_time);
         
-        // Ages the particle by 1 frame
-        particle->age += (1.0f / 60.0f);
+        // Ages the particle by the length of this frame
+        particle->age += delta_time;
         
         // Removes a particle from the queue if it's lifetime is up
         if (particle->age < particle_lifetime && particle->size >= 0.0f)
@@ -406,13 +401,13 @@ void ParticleSystem::OnUpdate()
     }
     
     // If this particle system has been emitting for longer than its duration then stop emitting.
-    if (!loop && framesActive / 60.0f > duration)
+    if (!loop && time_active > duration)
     {
         emitting = false;
     }
     else
     {
-        framesActive++;
+        time_active += delta_time;
     }
 }
 
@@ -0,0 +1,291 @@
+//
+//  Profiler.cpp
+//  wolverine_engine
+//
+//  Times each phase of the frame and keeps a rolling history of the results
+//
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "Profiler.h"
+#include "Renderer.h"
+#include "FileUtils.h"
+#include "LuaAllocator.h"
+
+// The names of each phase, in the same order as PROFILER_PHASE
+static const char* phase_names[PROFILER_PHASE_COUNT] = {
+    "Frame",
+    "Events",
+    "FixedUpdate",
+    "Physics",
+    "UpdateActors",
+    "AddedComponents",
+    "Update",
+    "Coroutines",
+    "LateUpdate",
+    "RemovedComponents",
+    "DestroyActors",
+    "RenderImages",
+    "RenderText",
+    "RenderPixels",
+    "RenderLines",
+    "RenderUI",
+    "Present",
+    "LuaGC",
+    "LoadScene"
+};
+
+/**
+ * Must be called before the first frame if profiling is wanted
+ *
+ * @param    num_history_frames    how many frames of timings to keep around
+ */
+void Profiler::Init(const int num_history_frames)
+{
+    history_frames = std::max(num_history_frames, 1);
+    history.assign(history_frames * PROFILER_PHASE_COUNT, 0.0f);
+    current_frame = 0;
+    frames_recorded = 0;
+    frame_open = false;
+
+    counter_to_ms = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    enabled = true;
+}
+
+/**
+ * Starts recording a new frame, overwriting the oldest one in the history
+ */
+void Profiler::BeginFrame()
+{
+    if (!enabled) { return; }
+
+    std::fill(history.begin() + current_frame * PROFILER_PHASE_COUNT, history.begin() + (current_frame + 1) * PROFILER_PHASE_COUNT, 0.0f);
+    frame_open = true;
+}
+
+/**
+ * Finishes the frame being recorded, it is included in the overlay and the report from now on
+ */
+void Profiler::EndFrame()
+{
+    if (!enabled || !frame_open) { return; }
+
+    frame_open = false;
+    if (frames_recorded < history_frames) { frames_recorded++; }
+    current_frame = (current_frame + 1) % history_frames;
+}
+
+/**
+ * Adds time to a phase of the current frame.
+ * Phases that run more than once in a frame (physics steps, etc.) add up.
+ *
+ * @param    phase       the phase that the time was spent in
+ * @param    start       the performance counter value when the phase started
+ * @param    end         the performance counter value when the phase ended
+ */
+void Profiler::AddSample(const PROFILER_PHASE phase, const Uint64 start, const Uint64 end)
+{
+    // Ex: the initial scene load, which happens before the first frame and is covered by the startup report instead
+    if (!frame_open) { return; }
+
+    history[current_frame * PROFILER_PHASE_COUNT + phase] += static_cast<float>((end - start) * counter_to_ms);
+}
+
+/**
+ * Queues the bar graph overlay into the text render queue, if the overlay is visible
+ */
+void Profiler::DrawOverlay()
+{
+    if (!enabled || !overlay_visible) { return; }
+
+    if (overlay_font == "")
+    {
+        std::cout << "error: profiler_font must be set in game.config to show the profiler overlay" << std::endl;
+        overlay_visible = false;
+        return;
+    }
+
+    const int font_size = 14;
+    const int line_height = 16;
+    const int bar_characters_per_ms = 3;
+    const int max_bar_characters = 75;
+
+    for (int phase = 0; phase < PROFILER_PHASE_COUNT; phase++)
+    {
+        // Averaged over a second's worth of frames so the numbers are readable
+        float average_ms = GetAverage(static_cast<PROFILER_PHASE>(phase), 60);
+
+        std::stringstream time_text;
+        time_text << std::fixed << std::setprecision(2) << average_ms << " ms";
+
+        int bar_length = std::min(static_cast<int>(average_ms * bar_characters_per_ms), max_bar_characters);
+        std::string bar(bar_length, '|');
+
+        int y = 10 + phase * line_height;
+        RendererData::DrawText(phase_names[phase], 10, y, overlay_font, font_size, 255, 80, 0, 255);
+        RendererData::DrawText(time_text.str(), 170, y, overlay_font, font_size, 255, 80, 0, 255);
+        if (bar_length > 0)
+        {
+            RendererData::DrawText(bar, 250, y, overlay_font, font_size, 255, 80, 0, 255);
+        }
+    }
+
+    int y = 10 + PROFILER_PHASE_COUNT * line_height;
+    RendererData::DrawText(LuaAllocator::GetSummary(), 10, y, overlay_font, font_size, 255, 80, 0, 255);
+}
+
+/**
+ * Writes the min, average, and 99th percentile of every phase over the recorded history to a CSV file
+ */
+void Profiler::WriteReport()
+{
+    if (!enabled || frames_recorded == 0) { return; }
+
+    std::ofstream report(FileUtils::GetPath(report_path));
+    if (!report.is_open())
+    {
+        std::cout << "error: could not write profiler report to " << report_path << std::endl;
+        return;
+    }
+
+    report << "phase,min_ms,avg_ms,p99_ms,max_ms,frames\n";
+
+    // Only finished frames are reported
+    std::vector<float> samples;
+    samples.reserve(frames_recorded);
+    for (int phase = 0; phase < PROFILER_PHASE_COUNT; phase++)
+    {
+        samples.clear();
+        for (int i = 1; i <= frames_recorded; i++)
+        {
+            int frame = (current_frame - i + history_frames) % history_frames;
+            samples.push_back(history[frame * PROFILER_PHASE_COUNT + phase]);
+        }
+        std::sort(samples.begin(), samples.end());
+
+        float total = 0.0f;
+        for (float sample : samples) { total += sample; }
+
+        size_t p99_index = std::min(samples.size() - 1, static_cast<size_t>(samples.size() * 0.99f));
+
+        report << phase_names[phase] << ","
+               << samples.front() << ","
+               << total / samples.size() << ","
+               << samples[p99_index] << ","
+               << samples.back() << ","
+               << samples.size() << "\n";
+    }
+
+    std::cout << "profiler report written to " << report_path << std::endl;
+}
+
+/**
+ * Records how long a stage of startup took
+ *
+ * @param    name     the name of the stage, must point to a string that lives for the whole run
+ * @param    start    the performance counter value when the stage started
+ * @param    end      the performance counter value when the stage ended
+ */
+void Profiler::AddStartupStage(const char* name, const Uint64 start, const Uint64 end)
+{
+    // Startup happens before Init, so counter_to_ms can't be used yet
+    float ms = static_cast<float>((end - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()));
+    startup_stages.emplace_back(name, ms);
+}
+
+/**
+ * Prints how long each stage of startup took, and how long startup took in total
+ *
+ * @param    total_ms    the wall time of the whole startup in milliseconds
+ */
+void Profiler::PrintStartupReport(const float total_ms)
+{
+    std::stringstream report;
+    report << std::fixed << std::setprecision(2);
+    report << "startup took " << total_ms << " ms" << std::endl;
+    for (const auto& [name, ms] : startup_stages)
+    {
+        report << "  " << name << ": " << ms << " ms" << std::endl;
+    }
+
+    std::cout << report.str();
+}
+
+//-------------------------------------------------------
+// Getters/Setters
+
+/**
+ * Shows or hides the bar graph overlay
+ *
+ * @param    visible    true to show the overlay
+ */
+void Profiler::SetOverlayVisible(const bool visible)
+{
+    overlay_visible = visible;
+}
+
+/**
+ * Flips the bar graph overlay between shown and hidden
+ */
+void Profiler::ToggleOverlay()
+{
+    overlay_visible = !overlay_visible;
+}
+
+/**
+ * Sets the font that the overlay is drawn with
+ *
+ * @param    font_name    the name of a font in resources/fonts
+ */
+void Profiler::SetOverlayFont(const std::string& font_name)
+{
+    overlay_font = font_name;
+}
+
+/**
+ * Sets the file that the report is written to when the game closes
+ *
+ * @param    path    the path of the CSV file
+ */
+void Profiler::SetReportPath(const std::string& path)
+{
+    report_path = path;
+}
+
+/**
+ * Gets the name of a phase, used for the overlay and the report
+ *
+ * @param    phase    the phase to get the name of
+ * @returns           the name of the phase
+ */
+const char* Profiler::GetPhaseName(const PROFILER_PHASE phase)
+{
+    return phase_names[phase];
+}
+
+/**
+ * Gets the average time spent in a phase over the last few frames
+ *
+ * @param    phase         the phase to average
+ * @param    num_frames    how many of the most recent frames to average over
+ * @returns                the average time in milliseconds
+ */
+float Profiler::GetAverage(const PROFILER_PHASE phase, int num_frames)
+{
+    num_frames = std::min(num_frames, frames_recorded);
+    if (num_frames <= 0) { return 0.0f; }
+
+    float total = 0.0f;
+    for (int i = 1; i <= num_frames; i++)
+    {
+        int frame = (current_frame - i + history_frames) % history_frames;
+        total += history[frame * PROFILER_PHASE_COUNT + phase];
+    }
+
+    return total / num_frames;
+}
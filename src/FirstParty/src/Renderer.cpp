@@ -22,11 +22,14 @@ SDL_Texture* RendererData::ConvertTextToTexture(SDL_Renderer* renderer, const st
 
 /**
 * Initializes the renderer
+* Does nothing in headless mode, no window or renderer is ever created.
 *
 * @param	title	the title of the window to create
 */
 void RendererData::Init(const std::string& title)
 {
+    if (headless) { return; }
+    
     SDL_Window* window = SDL_CreateWindow(title.c_str(), window_position.x, window_position.y, window_size.x, window_size.y, SDL_WINDOW_SHOWN);
     SetWindow(window);
     SDL_Renderer* renderer = SDL_CreateRenderer(RendererData::window, -1, SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_ACCELERATED);
@@ -291,6 +294,8 @@ void RendererData::RenderAndClearAllLines()
 */
 void RendererData::DrawUI(const std::string& image_name, const float x, const float y)
 {
+	if (headless) { headless_draw_count++; return; }
+
 	UIRenderRequest obj;
 	obj.image_name = image_name;
 	obj.x = static_cast<int>(x);
@@ -314,6 +319,8 @@ void RendererData::DrawUI(const std::string& image_name, const float x, const fl
 */
 void RendererData::DrawUIEx(const std::string& image_name, const float x, const float y, const float r, const float g, const float b, const float a, const float sorting_order)
 {
+	if (headless) { headless_draw_count++; return; }
+
 	UIRenderRequest obj;
 	obj.image_name = image_name;
 	obj.x = static_cast<int>(x);
@@ -336,6 +343,8 @@ void RendererData::DrawUIEx(const std::string& image_name, const float x, const
 */
 void RendererData::DrawImage(const std::string& image_name, const float x, const float y)
 {
+	if (headless) { headless_draw_count++; return; }
+
 	ImageDrawRequest obj;
 	obj.image_name = image_name;
 	obj.x = x;
@@ -363,6 +372,8 @@ void RendererData::DrawImage(const std::string& image_name, const float x, const
 */
 void RendererData::DrawImageEx(const std::string& image_name, const float x, const float y, const float rotation_degrees, const float scale_x, const float scale_y, const float pivot_x, const float pivot_y, const float r, const float g, const float b, const float a, const float sorting_order)
 {
+	if (headless) { headless_draw_count++; return; }
+
 	ImageDrawRequest obj;
 	obj.image_name = image_name;
 	obj.x = x;
@@ -393,6 +404,8 @@ void RendererData::DrawImageEx(const std::string& image_name, const float x, con
 */
 void RendererData::DrawPixel(const float x, const float y, const float r, const float g, const float b, const float a)
 {
+	if (headless) { headless_draw_count++; return; }
+
 	PixelDrawRequest obj;
 	obj.x = static_cast<int>(x);
 	obj.y = static_cast<int>(y);
@@ -418,6 +431,8 @@ Creates a line draw request from the specified (x1, y1) to (x2, y2) world positi
 */
 void RendererData::DrawLine(const float x1, const float y1, const float x2, const float y2, const float r, const float g, const float b, const float a)
 {
+    if (headless) { headless_draw_count++; return; }
+
     LineDrawRequest obj;
     obj.x1 = x1;
     obj.y1 = y1;
@@ -446,6 +461,8 @@ void RendererData::DrawLine(const float x1, const float y1, const float x2, cons
 */
 void RendererData::DrawText(const std::string str_content, int x, int y, std::string font_name, int font_size, int r, int g, int b, int a)
 {
+	if (headless) { headless_draw_count++; return; }
+
 	TextRenderRequest obj;
 	obj.text = str_content;
 	obj.font = font_name;
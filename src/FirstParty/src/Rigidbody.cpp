@@ -26,6 +26,7 @@ void Rigidbody::OnStart()
 	body_def.bullet = precise;
 	body_def.angularDamping = angular_friction;
 	body_def.gravityScale = gravity_scale;
+	body_def.userData.pointer = reinterpret_cast<uintptr_t>(&interpolation);
 
 	body = PhysicsWorld::world->CreateBody(&body_def);
 
@@ -84,6 +85,10 @@ void Rigidbody::OnStart()
 	// must be called after the body is created
 	SetRotation(rotation);
 
+	// There is no previous step yet, so don't interpolate from the origin
+	interpolation.previous_position = body->GetPosition();
+	interpolation.previous_angle = body->GetAngle();
+
 }
 
 /**
@@ -91,10 +96,21 @@ void Rigidbody::OnStart()
 */
 void Rigidbody::OnDestroy()
 {
-    if (body == nullptr)
-        return;
-    
+	Release();
+}
+
+/**
+* Destroys the rigidbody's body, called whenever the component is removed even if "OnDestroy" is skipped
+* The body points at this component, so it can't outlive it
+*/
+void Rigidbody::Release()
+{
+	if (body == nullptr)
+		return;
+
+	body->GetUserData().pointer = reinterpret_cast<uintptr_t>(nullptr);
 	PhysicsWorld::world->DestroyBody(body);
+	body = nullptr;
 }
 
 /**
@@ -137,6 +153,9 @@ void Rigidbody::SetPosition(const b2Vec2& position)
 	else {
 		float current_rotation = body->GetAngle();
 		body->SetTransform(position, current_rotation);
+
+		// Teleport instead of sliding from the old position
+		interpolation.previous_position = position;
 	}
 }
 
@@ -152,6 +171,7 @@ void Rigidbody::SetRotation(const float degrees_clockwise)
 	else {
 		// convert to radians and apply
 		body->SetTransform(body->GetPosition(), static_cast<int>(degrees_clockwise) * (b2_pi / 180.0f));
+		interpolation.previous_angle = body->GetAngle();
 	}
 }
 
@@ -247,6 +267,37 @@ float Rigidbody::GetRotation()
 	return body->GetAngle() * (180.0f / b2_pi);
 }
 
+/**
+* Get the (x, y) position of the rigidbody blended between the last two simulation steps.
+* Use this when drawing the rigidbody so that it moves smoothly regardless of the frame rate.
+*
+* @returns    a b2Vec2 containing the interpolated (x, y) position of the rb
+*/
+b2Vec2 Rigidbody::GetInterpolatedPosition()
+{
+	if (body == nullptr) // OnStart hasn't been called yet
+		return b2Vec2(x, y);
+
+	float alpha = Time::GetInterpolationAlpha();
+	b2Vec2 current_position = body->GetPosition();
+	return interpolation.previous_position + alpha * (current_position - interpolation.previous_position);
+}
+
+/**
+* Get the rotation of the rigidbody blended between the last two simulation steps
+*
+* @returns    a float of the interpolated rotation of the rb in clockwise degrees
+*/
+float Rigidbody::GetInterpolatedRotation()
+{
+	if (body == nullptr) // OnStart hasn't been called yet
+		return rotation;
+
+	float alpha = Time::GetInterpolationAlpha();
+	float angle = interpolation.previous_angle + alpha * (body->GetAngle() - interpolation.previous_angle);
+	return angle * (180.0f / b2_pi);
+}
+
 /**
 * Returns the current velocity of the rigidbody
 *
@@ -10,7 +10,10 @@
 
 #include "SceneManager.h"
 
+#include "Coroutines.h"
 #include "LuaAPI.h"
+#include "Profiler.h"
+#include "LuaGC.h"
 
 std::string Scene::current_scene_name = ""; // The name of this scene
 int Scene::current_scene_lifetime = 0; // The number of frames this scene has been active for
@@ -31,18 +34,15 @@ void Scene::UpdateActors()
 {
     current_scene_lifetime++;
     
-    // Cleans up all of the dead actors in the actor database
-    if (current_scene_lifetime % 60 == 0)
-    {
-        Actors::Cleanup();
-    }
-    
     // Process all of the components added to actors on the previous frame
     Actors::ProcessAddedComponents();
     
     // Update all actors
     Actors::Update();
     
+    // Resume the coroutines that are due
+    Coroutines::Update();
+    
     // Late update all actors
     Actors::LateUpdate();
     
@@ -50,28 +50,24 @@ void Scene::UpdateActors()
     Actors::ProcessRemovedComponents();
     
     // Destroys all of the dead actors
-    // TODO: Take another look at how to remove dead actors from a scene, this feels VERY slow
-    for (auto actor : dead_actors)
+    ProfileScope scope(PROFILER_PHASE_DESTROY_ACTORS);
+    // Removed from the scene first, the name of an actor can't be looked up once it is destroyed
+    for (int actor : dead_actors)
     {
-        // Destroy all of the actors that have been prepped for destruction.
-        Actors::DestroyActor(actor);
-        
-        int index_to_remove = -1;
-        // Find the index of the actor within 'actors' and delete it
-        for (int i = 0; i < actors.size(); i++)
-        {
-            if (actor == actors[i])
-            {
-                index_to_remove = i;
-                break;
-            }
-        }
-        // Erase the dead actor
-        if (index_to_remove != -1) { actors.erase(actors.begin() + index_to_remove); }
+        RemoveActor(actor);
     }
+    Actors::DestroyActors(dead_actors);
     dead_actors.clear();
 }
 
+/**
+ * Runs a single simulation step for all of the actors in this scene
+*/
+void Scene::FixedUpdateActors()
+{
+    Actors::FixedUpdate();
+}
+
 //-------------------------------------------------------
 // Loaders
 
@@ -89,13 +85,7 @@ void Scene::ChangeScene(std::string scene_name)
     load_new_scene = true;
     
     // Prepare all of the actors in this scene for deletion
-    for (auto& actor_id : actors)
-    {
-        Actor to_destroy;
-        to_destroy.ID = actor_id;
-        
-        Destroy(to_destroy);
-    }
+    DestroyAll();
 }
 
 /**
@@ -104,46 +94,45 @@ void Scene::ChangeScene(std::string scene_name)
 */
 void Scene::LoadNewScene()
 {
+    ProfileScope scope(PROFILER_PHASE_LOAD_SCENE);
+    
     load_new_scene = false;
-    current_scene_name = new_scene_name;
-    current_scene_lifetime = 0;
     
-    rapidjson::Document scene_document;
-    EngineUtils::ReadJsonFile(GetScenePath(new_scene_name), scene_document);
+    // The scene file is only read and compiled the first time the scene is loaded
+    LoadSceneWithBlueprints(new_scene_name, Blueprints::GetSceneBlueprints(new_scene_name));
     
-    if (scene_document.HasMember("actors"))
-    {
-        // Load all of the new actors into the game
-        for (auto& member : (scene_document)["actors"].GetArray())
-        {
-            // If the actor has a value for template, combine the actor with the template before loading it
-            if (member.HasMember("template"))
-            {
-                rapidjson::Document combined_actor;
-                
-                rapidjson::Document lhs;
-                lhs.CopyFrom(member, lhs.GetAllocator());
-                rapidjson::Document rhs;
-                rhs.CopyFrom(*GetTemplate(member["template"].GetString()), rhs.GetAllocator());
+    // A scene load is already a hitch, so it is a good time to clear out all of the Lua garbage at once
+    LuaGC::FullCollect();
+}
 
-                EngineUtils::CombineJsonDocuments(lhs, rhs, combined_actor);
-                
-                // FOR TESTS: Output the combined JSON as a string
-                // rapidjson::StringBuffer buffer;
-                // rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
-                // combined_actor.Accept(writer);
-                // std::cout << buffer.GetString() << std::endl;
-                
-                actors.push_back(Actors::LoadActorWithJSON(combined_actor));
-            }
-            else
-            {
-                actors.push_back(Actors::LoadActorWithJSON(member));
-            }
-        }
+/**
+ * Loads every actor in a scene document into the game and makes it the current scene
+ * LoadNewScene reads the document from resources/scenes, tools can build one in memory instead
+ *
+ * @param   scene_name      the name to give the loaded scene
+ * @param   scene_data      the scene document, structured the same as a .scene file
+*/
+void Scene::LoadSceneWithJSON(const std::string& scene_name, const rapidjson::Value& scene_data)
+{
+    LoadSceneWithBlueprints(scene_name, Blueprints::CompileScene(scene_data));
+}
+
+/**
+ * Loads an actor from every blueprint into the game and makes it the current scene
+ *
+ * @param   scene_name      the name to give the loaded scene
+ * @param   blueprints      the blueprint of every actor in the scene
+*/
+void Scene::LoadSceneWithBlueprints(const std::string& scene_name, const std::vector<std::unique_ptr<ActorBlueprint>>& blueprints)
+{
+    current_scene_name = scene_name;
+    current_scene_lifetime = 0;
+    
+    // Load all of the new actors into the game
+    for (const auto& blueprint : blueprints)
+    {
+        AddActor(Actors::LoadActorWithBlueprint(*blueprint));
     }
-    // Return after loading the needed scene
-    return;
 }
 
 /**
@@ -154,14 +143,54 @@ void Scene::LoadNewScene()
 */
 int Scene::Instantiate(std::string actor_template_name)
 {
-    // Creates the actor
-    int new_actor_id = Actors::LoadActorWithJSON(*GetTemplate(actor_template_name));
+    // Creates the actor, reusing a destroyed one if the template is pooled
+    int new_actor_id = Actors::LoadActorFromTemplate(actor_template_name);
     // Adds the actor to the scene
-    actors.push_back(new_actor_id);
+    AddActor(new_actor_id);
     
     return new_actor_id;
 }
 
+/**
+ * Creates many actors from a template and adds them to the current scene
+ * Cheaper than calling Instantiate in a loop, the template is looked up once and storage for every actor is made at once
+ *
+ * @param   actor_template_name    the name of the template to make copies of in the scene
+ * @param   count                  the number of actors to create
+ * @param   init_fn                called as init_fn(actor_id, i) for each new actor before any of them start, to set per-instance values
+ * @returns                        a list of the ids of the newly created actors
+*/
+sol::table Scene::InstantiateMany(std::string actor_template_name, int count, sol::optional<sol::protected_function> init_fn)
+{
+    std::vector<int> new_actor_ids;
+    Actors::LoadActorsFromTemplate(actor_template_name, count, new_actor_ids);
+    
+    // Adds the actors to the scene and fills the list that is given back to Lua
+    actors.reserve(actors.size() + new_actor_ids.size());
+    sol::table new_actors = LuaAPI::GetLuaState()->create_table(static_cast<int>(new_actor_ids.size()), 0);
+    for (int i = 0; i < static_cast<int>(new_actor_ids.size()); i++)
+    {
+        AddActor(new_actor_ids[i]);
+        new_actors.raw_set(i + 1, new_actor_ids[i]);
+    }
+    
+    // "OnStart" isn't called until next frame, so anything init_fn sets is there when the actors start
+    if (init_fn)
+    {
+        for (int i = 0; i < static_cast<int>(new_actor_ids.size()); i++)
+        {
+            sol::protected_function_result result = (*init_fn)(new_actor_ids[i], i + 1);
+            if (!result.valid())
+            {
+                sol::error error = result;
+                std::cout << "\033[31m" << actor_template_name << " : " << error.what() << "\033[0m" << std::endl;
+            }
+        }
+    }
+    
+    return new_actors;
+}
+
 /**
  * destroys an actor and then removes it from the scene
  *
@@ -174,6 +203,110 @@ void Scene::Destroy(Actor actor)
     Actors::PrepareActorForDestruction(actor.ID);
 }
 
+/**
+ * Destroys every actor in a list and removes them from the scene
+ *
+ * @param   actors_to_destroy    a Lua list of actors or actor IDs
+*/
+void Scene::DestroyMany(sol::table actors_to_destroy)
+{
+    for (const auto& [key, value] : actors_to_destroy)
+    {
+        int actor_id = -1;
+        if (value.is<Actor>()) { actor_id = value.as<Actor>().ID; }
+        else if (value.get_type() == sol::type::number) { actor_id = value.as<int>(); }
+        else { continue; }
+        
+        dead_actors.push_back(actor_id);
+        Actors::PrepareActorForDestruction(actor_id);
+    }
+}
+
+/**
+ * Destroys every actor in the scene
+*/
+void Scene::DestroyAll()
+{
+    dead_actors.insert(dead_actors.end(), actors.begin(), actors.end());
+    Actors::PrepareActorsForDestruction(actors);
+}
+
+/**
+ * Adds an actor to the list of actors in the scene
+ *
+ * @param   actor_id    the id of the actor to add
+*/
+void Scene::AddActor(int actor_id)
+{
+    int slot = Actors::GetSlot(actor_id);
+    if (slot >= static_cast<int>(actor_positions.size()))
+    {
+        actor_positions.resize(slot + 1, -1);
+        name_positions.resize(slot + 1, -1);
+    }
+    
+    actor_positions[slot] = static_cast<int>(actors.size());
+    actors.push_back(actor_id);
+    
+    int name_id = Actors::GetNameID(actor_id);
+    if (name_id >= static_cast<int>(actors_by_name.size())) { actors_by_name.resize(StringTable::GetCount()); }
+    
+    SceneNameBucket& bucket = actors_by_name[name_id];
+    name_positions[slot] = static_cast<int>(bucket.actors.size());
+    bucket.actors.push_back(actor_id);
+}
+
+/**
+ * Removes an actor from the list of actors in the scene by moving the last actor into its place
+ *
+ * @param   actor_id    the id of the actor to remove, does nothing if it isn't in the scene
+*/
+void Scene::RemoveActor(int actor_id)
+{
+    int slot = Actors::GetSlot(actor_id);
+    if (actor_id < 0 || slot >= static_cast<int>(actor_positions.size())) { return; }
+    
+    // The position has to belong to this exact ID, the slot could have been reused by a newer actor
+    int position = actor_positions[slot];
+    if (position == -1 || actors[position] != actor_id) { return; }
+    
+    int last_actor = actors.back();
+    actors[position] = last_actor;
+    actor_positions[Actors::GetSlot(last_actor)] = position;
+    actors.pop_back();
+    actor_positions[slot] = -1;
+    
+    // Name buckets keep their order, so the actor is marked as removed instead of being swapped out
+    SceneNameBucket& bucket = actors_by_name[Actors::GetNameID(actor_id)];
+    bucket.actors[name_positions[slot]] = -1;
+    bucket.num_removed++;
+    name_positions[slot] = -1;
+    
+    while (bucket.first_live < static_cast<int>(bucket.actors.size()) && bucket.actors[bucket.first_live] == -1) { bucket.first_live++; }
+    if (bucket.num_removed * 2 > static_cast<int>(bucket.actors.size())) { CompactNameBucket(bucket); }
+}
+
+/**
+ * Packs a name bucket after enough of its actors have been removed
+ *
+ * @param   bucket    the bucket to pack
+*/
+void Scene::CompactNameBucket(SceneNameBucket& bucket)
+{
+    int next = 0;
+    for (int actor_id : bucket.actors)
+    {
+        if (actor_id == -1) { continue; }
+        
+        name_positions[Actors::GetSlot(actor_id)] = next;
+        bucket.actors[next] = actor_id;
+        next++;
+    }
+    bucket.actors.resize(next);
+    bucket.first_live = 0;
+    bucket.num_removed = 0;
+}
+
 //-------------------------------------------------------
 // Getters/Setters
 
@@ -189,55 +322,93 @@ std::string Scene::GetSceneName()
 
 /**
  * Finds an actor in the current scene that has the provided name
- * If multiple actors have this name this returns the one that was loaded first
+ * If multiple actors have this name this returns the one that was added to the scene first
  *
  * @param   actor_name    the name of the actor that this function is trying to find
  * @returns               the found actor
 */
-Actor Scene::FindActorWithName(std::string actor_name)
+Actor Scene::FindActorWithName(std::string_view actor_name)
+{
+    // Names that were never interned can't belong to any actor
+    return FindActorWithNameID(StringTable::Find(actor_name));
+}
+
+/**
+ * Finds all actors in the current scene that have the provided name
+ *
+ * @param   actor_name    the name of the actors that this function is trying to find
+ * @returns               a list of indexes that represent actors with the given name
+*/
+sol::table Scene::FindAllActorsWithName(std::string_view actor_name)
+{
+    return FindAllActorsWithNameID(StringTable::Find(actor_name));
+}
+
+/**
+ * Gets the ID of a name, for scripts that search for the same name often
+ * The ID stays the same for the whole run, so it can be looked up once and kept
+ *
+ * @param   actor_name    the name to get the ID of
+ * @returns               the ID of the name
+*/
+int Scene::GetNameID(std::string_view actor_name)
+{
+    return StringTable::Intern(actor_name);
+}
+
+/**
+ * Same as FindActorWithName, but takes a name ID from GetNameID
+ *
+ * @param   name_id    the ID of the name of the actor that this function is trying to find
+ * @returns            the found actor
+*/
+Actor Scene::FindActorWithNameID(int name_id)
 {
     // Create a new actor that will be assigned with the value of our actor with the given name if one is found
     Actor found_actor;
     found_actor.ID = -1;
     
-    // Find the actor
-    for (auto& actor_id : actors)
+    if (name_id < 0 || name_id >= static_cast<int>(actors_by_name.size())) { return found_actor; }
+    
+    const SceneNameBucket& bucket = actors_by_name[name_id];
+    if (bucket.first_live < static_cast<int>(bucket.actors.size()))
     {
-        if (Actors::GetName(actor_id) == actor_name)
-        {
-            found_actor.ID = actor_id;
-            return found_actor;
-        }
+        found_actor.ID = bucket.actors[bucket.first_live];
     }
     
     return found_actor;
 }
 
 /**
- * Finds all actors in the current scene that have the provided name
+ * Same as FindAllActorsWithName, but takes a name ID from GetNameID
  *
- * @param   actor_name    the name of the actors that this function is trying to find
- * @returns               a list of indexes that represent actors with the given name
+ * @param   name_id    the ID of the name of the actors that this function is trying to find
+ * @returns            a list of indexes that represent actors with the given name
 */
-sol::table Scene::FindAllActorsWithName(std::string actor_name)
+sol::table Scene::FindAllActorsWithNameID(int name_id)
 {
+    bool has_bucket = name_id >= 0 && name_id < static_cast<int>(actors_by_name.size());
+    int num_found = has_bucket ? static_cast<int>(actors_by_name[name_id].actors.size()) - actors_by_name[name_id].num_removed : 0;
+    
     // Create a new empty lua table to fill with our actors, and make it 1 indexed so it can be looped through in lua
-    sol::table actors_with_name = LuaAPI::GetLuaState()->create_table();
+    sol::table actors_with_name = LuaAPI::GetLuaState()->create_table(num_found, 0);
     actors_with_name[0] = sol::object(*LuaAPI::GetLuaState());
     
+    if (!has_bucket) { return actors_with_name; }
+    
     // Fill the table
     // Keys must be increasing integers so the table is ipairs compatable
     int i = 1;
-    for (auto& actor_id : actors)
+    const SceneNameBucket& bucket = actors_by_name[name_id];
+    for (size_t position = bucket.first_live; position < bucket.actors.size(); position++)
     {
-        if (Actors::GetName(actor_id) == actor_name)
-        {
-            // Add our actor with the given name to the list
-            Actor found_actor;
-            found_actor.ID = actor_id;
-            actors_with_name[i] = found_actor;
-            i++;
-        }
+        if (bucket.actors[position] == -1) { continue; }
+        
+        // Add our actor with the given name to the list
+        Actor found_actor;
+        found_actor.ID = bucket.actors[position];
+        actors_with_name[i] = found_actor;
+        i++;
     }
     
     return actors_with_name;
@@ -0,0 +1,253 @@
+//
+//  ScriptProfiler.cpp
+//  wolverine_engine
+//
+//  Times every Lua lifecycle callback by component type and key so script hot spots can be found
+//
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#include "ScriptProfiler.h"
+#include "ActorManager.h"
+#include "LuaAPI.h"
+#include "StringTable.h"
+
+// The names of each callback, in the same order as SCRIPT_CALLBACK
+static const char* callback_names[SCRIPT_CALLBACK_COUNT] = {
+    "OnStart",
+    "OnUpdate",
+    "OnLateUpdate",
+    "OnFixedUpdate",
+    "OnDestroy",
+    "OnCollisionEnter",
+    "OnCollisionExit",
+    "OnTriggerEnter",
+    "OnTriggerExit",
+    "OnUpdateAll",
+    "OnLateUpdateAll",
+    "OnFixedUpdateAll"
+};
+
+/**
+ * @param    type_id    the ID of a component type, -1 if it isn't known
+ * @returns             the name of the type
+ */
+static const std::string& GetTypeName(const int type_id)
+{
+    static const std::string unknown = "???";
+    return type_id == -1 ? unknown : StringTable::GetString(type_id);
+}
+
+/**
+ * @param    key_id    the ID of a component key, -1 for batched callbacks
+ * @returns            the key
+ */
+static const std::string& GetKeyName(const int key_id)
+{
+    static const std::string every_key = "*";
+    return key_id == -1 ? every_key : StringTable::GetString(key_id);
+}
+
+/**
+ * @param    name_id    the ID of an actor's name, -1 if there was no actor
+ * @returns             the name
+ */
+static const std::string& GetActorName(const int name_id)
+{
+    static const std::string no_name = "";
+    return name_id == -1 ? no_name : StringTable::GetString(name_id);
+}
+
+/**
+ * Must be called before the first frame if script profiling is wanted
+ *
+ * @param    interval_frames    how many frames between each console report, 0 turns the report off
+ * @param    top_n              how many of the slowest callbacks are printed in each report
+ */
+void ScriptProfiler::Init(const int interval_frames, const int top_n)
+{
+    report_interval_frames = std::max(interval_frames, 0);
+    report_top_n = std::max(top_n, 1);
+    frames_since_report = 0;
+
+    counter_to_ms = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    enabled = true;
+}
+
+/**
+ * Adds a single call of a callback to the profile
+ *
+ * @param    type_id     the ID of the type of the component the callback was called on
+ * @param    key_id      the ID of the key of the component, -1 for batched callbacks
+ * @param    callback    which callback was called
+ * @param    actor_id    the id of the actor the component is on
+ * @param    start       the performance counter value when the call started
+ * @param    end         the performance counter value when the call ended
+ */
+void ScriptProfiler::AddSample(const int type_id, const int key_id, const SCRIPT_CALLBACK callback, const int actor_id, const Uint64 start, const Uint64 end)
+{
+    // The IDs come from the component's record instead of its table, which the callback may have cleared by removing the component
+    auto [it, inserted] = entry_indexes[callback].try_emplace(GetEntryKey(type_id, key_id), static_cast<int>(entries.size()));
+    if (inserted)
+    {
+        ScriptProfileEntry& new_entry = entries.emplace_back();
+        new_entry.type_id = type_id;
+        new_entry.key_id = key_id;
+        new_entry.callback = callback;
+    }
+    int index = it->second;
+
+    ScriptProfileEntry& entry = entries[index];
+    float sample_ms = static_cast<float>((end - start) * counter_to_ms);
+
+    entry.calls++;
+    entry.total_ms += sample_ms;
+    entry.window_calls++;
+    entry.window_ms += sample_ms;
+
+    if (sample_ms > entry.max_ms)
+    {
+        entry.max_ms = sample_ms;
+        entry.worst_actor_name_id = Actors::GetNameID(actor_id);
+    }
+}
+
+/**
+ * Call once at the end of every frame, prints the console report when it is due
+ */
+void ScriptProfiler::EndFrame()
+{
+    if (!enabled || report_interval_frames == 0) { return; }
+
+    frames_since_report++;
+    if (frames_since_report >= report_interval_frames)
+    {
+        PrintReport(report_top_n);
+    }
+}
+
+/**
+ * Prints the callbacks that took the most time since the last report, then starts a new report window
+ *
+ * @param    top_n    how many callbacks to print
+ */
+void ScriptProfiler::PrintReport(const int top_n)
+{
+    std::vector<ScriptProfileEntry*> sorted_entries;
+    sorted_entries.reserve(entries.size());
+    for (auto& entry : entries)
+    {
+        if (entry.window_calls > 0) { sorted_entries.push_back(&entry); }
+    }
+
+    std::sort(sorted_entries.begin(), sorted_entries.end(), [](const ScriptProfileEntry* a, const ScriptProfileEntry* b) {
+        return a->window_ms > b->window_ms;
+    });
+
+    int num_printed = std::min(top_n, static_cast<int>(sorted_entries.size()));
+    
+    // Put the console formatting back the way it was after printing
+    std::ios_base::fmtflags old_flags = std::cout.flags();
+    std::streamsize old_precision = std::cout.precision();
+
+    std::cout << "script profile, last " << frames_since_report << " frames:" << std::endl;
+    for (int i = 0; i < num_printed; i++)
+    {
+        ScriptProfileEntry* entry = sorted_entries[i];
+        std::cout << std::fixed << std::setprecision(3)
+                  << "  " << GetTypeName(entry->type_id) << " (" << GetKeyName(entry->key_id) << ") " << callback_names[entry->callback]
+                  << ": " << entry->window_ms << " ms over " << entry->window_calls << " calls"
+                  << ", " << entry->window_ms / frames_since_report << " ms/frame"
+                  << ", slowest call " << entry->max_ms << " ms on " << GetActorName(entry->worst_actor_name_id) << std::endl;
+    }
+    std::cout.flags(old_flags);
+    std::cout.precision(old_precision);
+
+    // Start a new report window
+    for (auto& entry : entries)
+    {
+        entry.window_calls = 0;
+        entry.window_ms = 0.0;
+    }
+    frames_since_report = 0;
+}
+
+/**
+ * Throws away everything that has been recorded
+ */
+void ScriptProfiler::Reset()
+{
+    entries.clear();
+    for (auto& callback_indexes : entry_indexes) { callback_indexes.clear(); }
+    frames_since_report = 0;
+}
+
+//-------------------------------------------------------
+// Getters/Setters
+
+/**
+ * Gets the name of a callback
+ *
+ * @param    callback    the callback to get the name of
+ * @returns              the name of the lifecycle function
+ */
+const char* ScriptProfiler::GetCallbackName(const SCRIPT_CALLBACK callback)
+{
+    return callback_names[callback];
+}
+
+/**
+ * Gets the whole profile as a Lua table, sorted from most to least total time
+ * Each entry has type, key, callback, calls, total_ms, avg_ms, max_ms, and worst_actor
+ *
+ * @returns    a 1 indexed list of every profiled callback
+ */
+sol::table ScriptProfiler::GetProfile()
+{
+    std::vector<const ScriptProfileEntry*> sorted_entries;
+    sorted_entries.reserve(entries.size());
+    for (const auto& entry : entries) { sorted_entries.push_back(&entry); }
+
+    std::sort(sorted_entries.begin(), sorted_entries.end(), [](const ScriptProfileEntry* a, const ScriptProfileEntry* b) {
+        return a->total_ms > b->total_ms;
+    });
+
+    sol::table profile = LuaAPI::GetLuaState()->create_table();
+
+    // Keys must be increasing integers so the table is ipairs compatable
+    int i = 1;
+    for (const ScriptProfileEntry* entry : sorted_entries)
+    {
+        sol::table lua_entry = LuaAPI::GetLuaState()->create_table();
+        lua_entry["type"] = GetTypeName(entry->type_id);
+        lua_entry["key"] = GetKeyName(entry->key_id);
+        lua_entry["callback"] = callback_names[entry->callback];
+        lua_entry["calls"] = entry->calls;
+        lua_entry["total_ms"] = entry->total_ms;
+        lua_entry["avg_ms"] = (entry->calls > 0) ? entry->total_ms / entry->calls : 0.0;
+        lua_entry["max_ms"] = entry->max_ms;
+        lua_entry["worst_actor"] = GetActorName(entry->worst_actor_name_id);
+
+        profile[i] = lua_entry;
+        i++;
+    }
+
+    return profile;
+}
+
+/**
+ * Formats the actor name, component type, and key of a callback for the trace
+ *
+ * @param    type_id     the ID of the type of the component the callback was called on
+ * @param    key_id      the ID of the key of the component, -1 for batched callbacks
+ * @param    actor_id    the id of the actor the component is on
+ * @returns              the args of the callback's trace zone
+ */
+std::string ScriptProfiler::GetTraceArgs(const int type_id, const int key_id, const int actor_id)
+{
+    return "\"actor\":\"" + Tracer::Escape(Actors::GetName(actor_id)) + "\",\"type\":\"" + Tracer::Escape(GetTypeName(type_id)) + "\",\"key\":\"" + Tracer::Escape(GetKeyName(key_id)) + "\"";
+}
@@ -8,6 +8,7 @@
 #include "SpriteRenderer.h"
 #include "ActorManager.h"
 #include "PhysicsWorld.h"
+#include "Rigidbody.h"
 
 /**
 * Lifecycle function for initializing a sprite renderer
@@ -22,11 +23,12 @@ void SpriteRenderer::OnStart()
 void SpriteRenderer::OnUpdate()
 {
     // Sprite Renderer should render at the rigidbody's location if it exists
-    sol::table rb = Actors::GetComponentByType(actor->ID, "Rigidbody");
+    // The position is blended between simulation steps so the sprite moves smoothly at any frame rate
+    static const int rigidbody_type_id = Actors::GetComponentTypeID("Rigidbody");
+    sol::table rb = Actors::GetComponentByTypeID(actor->ID, rigidbody_type_id);
     if (rb.valid())
     {
-        sol::function GetPosition = (rb)["GetPosition"];
-        b2Vec2 pos = GetPosition(rb);
+        b2Vec2 pos = rb.as<Rigidbody&>().GetInterpolatedPosition();
         x = pos.x;
         y = pos.y;
     }
@@ -0,0 +1,41 @@
+//
+//  StringTable.cpp
+//  wolverine_engine
+//
+//  Interns strings that are compared often (actor names, component keys, etc.) so they can be compared and indexed by a small integer ID
+//
+
+#include "StringTable.h"
+
+/**
+ * Gets the ID of a string, adding it to the table if it isn't there yet
+ * IDs are dense and never change, so they can be used to index vectors
+ *
+ * @param    text    the string to intern
+ * @returns          the ID of the string
+ */
+int StringTable::Intern(std::string_view text)
+{
+    auto found = string_ids.find(text);
+    if (found != string_ids.end()) { return found->second; }
+
+    int string_id = static_cast<int>(strings.size());
+    const std::string& stored = strings.emplace_back(text);
+    string_ids.emplace(std::string_view(stored), string_id);
+
+    return string_id;
+}
+
+/**
+ * Gets the ID of a string without adding it to the table
+ *
+ * @param    text    the string to look up
+ * @returns          the ID of the string, -1 if it has never been interned
+ */
+int StringTable::Find(std::string_view text)
+{
+    auto found = string_ids.find(text);
+    if (found == string_ids.end()) { return -1; }
+
+    return found->second;
+}
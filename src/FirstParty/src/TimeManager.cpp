@@ -0,0 +1,160 @@
+//
+//  TimeManager.cpp
+//  wolverine_engine
+//
+//  Keeps track of the frame clock and drives the fixed simulation timestep.
+//
+
+#include "TimeManager.h"
+
+/**
+ * Must be called before the first frame, starts the frame clock
+ */
+void Time::Init()
+{
+    counter_frequency = SDL_GetPerformanceFrequency();
+    last_counter = SDL_GetPerformanceCounter();
+}
+
+/**
+ * Call once at the start of every frame.
+ * Measures how long the previous frame took and adds it to the simulation accumulator.
+ */
+void Time::BeginFrame()
+{
+    Uint64 current_counter = SDL_GetPerformanceCounter();
+    unscaled_delta_time = static_cast<float>(current_counter - last_counter) / static_cast<float>(counter_frequency);
+    last_counter = current_counter;
+    
+    if (frame_delta_override > 0.0f) { unscaled_delta_time = frame_delta_override; }
+
+    // Clamp the frame length so a long hitch (dragging the window, a breakpoint, etc.) doesn't cause a huge jump
+    if (unscaled_delta_time > max_delta_time) { unscaled_delta_time = max_delta_time; }
+
+    delta_time = unscaled_delta_time * time_scale;
+    time += delta_time;
+
+    accumulator += delta_time;
+    fixed_steps_this_frame = 0;
+}
+
+/**
+ * Takes one fixed step worth of time out of the accumulator if there is enough of it.
+ * Call in a loop to run the simulation: while (Time::ConsumeFixedStep()) { ... }
+ *
+ * @returns    true if a fixed step should be simulated, false once the simulation has caught up
+ */
+bool Time::ConsumeFixedStep()
+{
+    if (accumulator < fixed_delta_time) { return false; }
+
+    // The simulation can't keep up, drop the time we couldn't simulate instead of falling further behind
+    if (fixed_steps_this_frame >= max_fixed_steps_per_frame)
+    {
+        accumulator = 0.0f;
+        return false;
+    }
+
+    accumulator -= fixed_delta_time;
+    fixed_steps_this_frame++;
+    return true;
+}
+
+/**
+ * How far between the last two simulation steps the current frame is.
+ * Used to interpolate the positions of physics bodies when rendering.
+ *
+ * @returns    [0, 1] 0 is the previous simulation step and 1 is the current one
+ */
+float Time::GetInterpolationAlpha()
+{
+    float alpha = accumulator / fixed_delta_time;
+    if (alpha > 1.0f) { alpha = 1.0f; }
+    return alpha;
+}
+
+//-------------------------------------------------------
+// Getters/Setters
+
+/**
+ * @returns    the scaled number of seconds the last frame took
+ */
+float Time::GetDeltaTime()
+{
+    return delta_time;
+}
+
+/**
+ * @returns    the number of seconds the last frame took, ignoring the time scale
+ */
+float Time::GetUnscaledDeltaTime()
+{
+    return unscaled_delta_time;
+}
+
+/**
+ * @returns    the length of a single simulation step in seconds
+ */
+float Time::GetFixedDeltaTime()
+{
+    return fixed_delta_time;
+}
+
+/**
+ * Sets the length of a single simulation step
+ *
+ * @param    seconds    the new length of a simulation step in seconds
+ */
+void Time::SetFixedDeltaTime(const float seconds)
+{
+    if (seconds <= 0.0f) { return; }
+    fixed_delta_time = seconds;
+}
+
+/**
+ * @returns    how fast game time passes compared to real time
+ */
+float Time::GetTimeScale()
+{
+    return time_scale;
+}
+
+/**
+ * Sets how fast game time passes compared to real time
+ *
+ * @param    scale    0 pauses the game, 1 is real time, 2 is double speed, etc.
+ */
+void Time::SetTimeScale(const float scale)
+{
+    time_scale = (scale < 0.0f) ? 0.0f : scale;
+}
+
+/**
+ * @returns    the scaled number of seconds since the game started
+ */
+double Time::GetTime()
+{
+    return time;
+}
+
+/**
+ * Sets the maximum number of simulation steps that can be taken in a single frame
+ *
+ * @param    max_steps    the new maximum number of steps
+ */
+void Time::SetMaxFixedStepsPerFrame(const int max_steps)
+{
+    if (max_steps < 1) { return; }
+    max_fixed_steps_per_frame = max_steps;
+}
+
+/**
+ * Makes every frame advance game time by the same amount no matter how long it really took.
+ * Used by headless runs so the simulation stays deterministic while running uncapped.
+ *
+ * @param    seconds    the length of every frame, 0 goes back to measuring the frame clock
+ */
+void Time::SetFrameDeltaOverride(const float seconds)
+{
+    frame_delta_override = (seconds < 0.0f) ? 0.0f : seconds;
+}
@@ -0,0 +1,136 @@
+//
+//  Tracer.cpp
+//  wolverine_engine
+//
+//  Writes a timeline of engine zones to a Chrome trace event file that can be opened in Perfetto or chrome://tracing
+//
+
+#include <atomic>
+#include <iostream>
+
+#include "Tracer.h"
+
+/**
+ * Starts recording zones and opens the trace file
+ *
+ * @param    path    where the trace is written
+ * @returns          true if the file could be opened
+ */
+bool Tracer::Start(const std::string& path)
+{
+#ifdef _WIN32
+    fopen_s(&trace_file, path.c_str(), "wb");
+#else
+    trace_file = fopen(path.c_str(), "wb");
+#endif
+    if (trace_file == nullptr)
+    {
+        std::cout << "error: could not open " << path << " to write the trace" << std::endl;
+        return false;
+    }
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", trace_file);
+    first_event = true;
+
+    counter_to_us = 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    start_counter = SDL_GetPerformanceCounter();
+    events.reserve(flush_threshold);
+    enabled = true;
+
+#ifndef WOLVERINE_TRACING
+    std::cout << "warning: this build was made without WOLVERINE_TRACING, the trace will be empty" << std::endl;
+#endif
+
+    return true;
+}
+
+/**
+ * Writes everything that is left and closes the trace file, call before the game exits
+ */
+void Tracer::Finish()
+{
+    if (!enabled) { return; }
+    enabled = false;
+
+    std::lock_guard<std::mutex> lock(events_mutex);
+    FlushEvents();
+
+    fputs("\n]}\n", trace_file);
+    fclose(trace_file);
+    trace_file = nullptr;
+}
+
+/**
+ * Adds a finished zone to the trace
+ *
+ * @param    category    what part of the engine the zone is in
+ * @param    name        the name of the zone
+ * @param    start       the performance counter value when the zone started
+ * @param    end         the performance counter value when the zone ended
+ * @param    args        formatted JSON object members shown with the zone, can be empty
+ */
+void Tracer::AddEvent(const char* category, const char* name, const Uint64 start, const Uint64 end, std::string args)
+{
+    TraceEvent event;
+    event.category = category;
+    event.name = name;
+    event.start_us = static_cast<double>(start - start_counter) * counter_to_us;
+    event.duration_us = static_cast<double>(end - start) * counter_to_us;
+    event.thread_id = GetThreadID();
+    event.args = std::move(args);
+
+    std::lock_guard<std::mutex> lock(events_mutex);
+    if (!enabled) { return; }
+
+    events.push_back(std::move(event));
+    if (events.size() >= flush_threshold) { FlushEvents(); }
+}
+
+/**
+ * Writes every buffered event to the trace file
+ * events_mutex must be held by the caller
+ */
+void Tracer::FlushEvents()
+{
+    for (const TraceEvent& event : events)
+    {
+        fprintf(trace_file, "%s{\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"cat\":\"%s\",\"name\":\"%s\",\"ts\":%.3f,\"dur\":%.3f",
+                first_event ? "" : ",\n", event.thread_id, event.category, event.name, event.start_us, event.duration_us);
+        if (event.args != "")
+        {
+            fprintf(trace_file, ",\"args\":{%s}", event.args.c_str());
+        }
+        fputc('}', trace_file);
+        first_event = false;
+    }
+    events.clear();
+}
+
+/**
+ * Escapes a string so it can be put inside quotes in the trace file
+ *
+ * @param    text    the text to escape
+ * @returns          the escaped text
+ */
+std::string Tracer::Escape(const std::string& text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\') { escaped += '\\'; }
+        if (static_cast<unsigned char>(c) < 0x20) { continue; } // Control characters aren't worth keeping
+        escaped += c;
+    }
+    return escaped;
+}
+
+/**
+ * @returns    a small number that identifies the calling thread in the trace
+ */
+int Tracer::GetThreadID()
+{
+    static std::atomic<int> next_thread_id{1};
+    thread_local int thread_id = next_thread_id.fetch_add(1);
+    return thread_id;
+}
@@ -0,0 +1,81 @@
+//
+//  WorkerPool.cpp
+//  wolverine_engine
+//
+//  A small pool of worker threads for work that doesn't touch Lua or the renderer (decoding assets, parsing JSON, etc.)
+//
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "WorkerPool.h"
+
+/**
+ * Starts the worker threads
+ *
+ * @param    num_threads    the number of workers to start, 0 uses one less than the number of cores
+ */
+void WorkerPool::Init(int num_threads)
+{
+    if (!workers.empty()) { return; }
+
+    if (num_threads <= 0)
+    {
+        // Leave a core for the main thread, which keeps doing the Lua and renderer work while the workers run
+        num_threads = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1);
+    }
+
+    // Registered after "workers" was constructed, so it runs before the threads would be destroyed
+    if (!registered_exit_hook)
+    {
+        std::atexit(&WorkerPool::Shutdown);
+        registered_exit_hook = true;
+    }
+
+    stopping = false;
+    for (int i = 0; i < num_threads; i++)
+    {
+        workers.emplace_back(&WorkerPool::WorkerLoop);
+    }
+}
+
+/**
+ * Finishes every queued job and then stops the worker threads, does nothing if they aren't running
+ * Must be called from the main thread
+ */
+void WorkerPool::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex);
+        stopping = true;
+    }
+    jobs_available.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    workers.clear();
+}
+
+/**
+ * The loop every worker thread runs, takes jobs off the queue until the pool shuts down
+ */
+void WorkerPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(jobs_mutex);
+            jobs_available.wait(lock, [] { return stopping || !jobs.empty(); });
+
+            if (jobs.empty()) { return; } // Only happens once the pool is stopping
+
+            job = std::move(jobs.front());
+            jobs.pop();
+        }
+
+        job();
+    }
+}
@@ -8,6 +8,7 @@ using namespace std;
  */
 int main(int argc, char* argv[]) {
     FileUtils::SetWorkingDirectory();
+    ParseCommandLine(argc, argv);
     Game();
 	return 0;
 }